@@ -0,0 +1,109 @@
+#include "BatchKernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace Poker {
+    namespace {
+        inline __m256i Gather(const std::uint32_t* table, __m256i index) {
+            return _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), index, 4);
+        }
+
+        // 1 << (rank - TWO), shifts of rank 0 fall out of range and give 0
+        inline __m256i RankBit(__m256i rank) {
+            return _mm256_sllv_epi32(_mm256_set1_epi32(1), _mm256_sub_epi32(rank, _mm256_set1_epi32(2)));
+        }
+
+        // value where condition is non zero, 0 elsewhere
+        inline __m256i Where(__m256i condition, __m256i value) {
+            return _mm256_andnot_si256(_mm256_cmpeq_epi32(condition, _mm256_setzero_si256()), value);
+        }
+
+        inline __m256i Load(const std::uint16_t* suit) {
+            return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(suit)));
+        }
+    }
+
+    // ----------------------------   Public   ----------------------------
+    const bool BatchKernels::AVX2_COMPILED = true;
+
+    // Every category that is present is scored without branches, the best hand is the largest of them
+    std::size_t BatchKernels::EvaluateAvx2(const Tables& tables, const std::uint16_t* const suits[4], std::size_t count, std::uint32_t* strengths) {
+        const std::size_t LANES = 8;
+
+        std::size_t i = 0;
+        for (; i + LANES <= count; i += LANES) {
+            const __m256i clubs = Load(suits[0] + i);
+            const __m256i diamonds = Load(suits[1] + i);
+            const __m256i hearts = Load(suits[2] + i);
+            const __m256i spades = Load(suits[3] + i);
+
+            const __m256i clubsDiamonds = _mm256_and_si256(clubs, diamonds);
+            const __m256i heartsSpades = _mm256_and_si256(hearts, spades);
+            const __m256i ranks = _mm256_or_si256(_mm256_or_si256(clubs, diamonds), _mm256_or_si256(hearts, spades));
+            const __m256i quads = _mm256_and_si256(clubsDiamonds, heartsSpades);
+            const __m256i tripsPlus = _mm256_or_si256(
+                _mm256_and_si256(clubsDiamonds, _mm256_or_si256(hearts, spades)),
+                _mm256_and_si256(heartsSpades, _mm256_or_si256(clubs, diamonds)));
+            const __m256i pairsPlus = _mm256_or_si256(
+                _mm256_or_si256(clubsDiamonds, heartsSpades),
+                _mm256_and_si256(_mm256_or_si256(clubs, diamonds), _mm256_or_si256(hearts, spades)));
+
+            // Flushes, zero unless the suit holds five cards
+            __m256i best = _mm256_max_epu32(
+                _mm256_max_epu32(Gather(tables.flushes, clubs), Gather(tables.flushes, diamonds)),
+                _mm256_max_epu32(Gather(tables.flushes, hearts), Gather(tables.flushes, spades)));
+
+            // Four of a kind
+            const __m256i quad = Gather(tables.topCard, quads);
+            const __m256i quadKicker = Gather(tables.topCard, _mm256_andnot_si256(RankBit(quad), ranks));
+            best = _mm256_max_epu32(best, Where(quads, _mm256_or_si256(_mm256_set1_epi32(tables.typeBits[7]),
+                _mm256_or_si256(_mm256_slli_epi32(quad, 16), _mm256_slli_epi32(quadKicker, 12)))));
+
+            // Full house
+            const __m256i trip = Gather(tables.topCard, tripsPlus);
+            const __m256i fullHousePair = _mm256_andnot_si256(RankBit(trip), pairsPlus);
+            best = _mm256_max_epu32(best, Where(tripsPlus, Where(fullHousePair, _mm256_or_si256(_mm256_set1_epi32(tables.typeBits[6]),
+                _mm256_or_si256(_mm256_slli_epi32(trip, 16), _mm256_slli_epi32(Gather(tables.topCard, fullHousePair), 12))))));
+
+            // Straight
+            const __m256i straight = Gather(tables.straights, ranks);
+            best = _mm256_max_epu32(best, Where(straight, _mm256_or_si256(_mm256_set1_epi32(tables.typeBits[4]), _mm256_slli_epi32(straight, 16))));
+
+            // Three of a kind
+            const __m256i tripKickers = _mm256_and_si256(_mm256_srli_epi32(Gather(tables.topFive, _mm256_andnot_si256(RankBit(trip), ranks)), 4), _mm256_set1_epi32(0xFF00));
+            best = _mm256_max_epu32(best, Where(tripsPlus, _mm256_or_si256(_mm256_set1_epi32(tables.typeBits[3]),
+                _mm256_or_si256(_mm256_slli_epi32(trip, 16), tripKickers))));
+
+            // Two pair
+            const __m256i highPair = Gather(tables.topCard, pairsPlus);
+            const __m256i lowPair = Gather(tables.topCard, _mm256_andnot_si256(RankBit(highPair), pairsPlus));
+            const __m256i twoPairKicker = Gather(tables.topCard, _mm256_andnot_si256(_mm256_or_si256(RankBit(highPair), RankBit(lowPair)), ranks));
+            best = _mm256_max_epu32(best, Where(lowPair, _mm256_or_si256(_mm256_set1_epi32(tables.typeBits[2]),
+                _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(highPair, 16), _mm256_slli_epi32(lowPair, 12)), _mm256_slli_epi32(twoPairKicker, 8)))));
+
+            // Pair
+            const __m256i pairKickers = _mm256_and_si256(_mm256_srli_epi32(Gather(tables.topFive, _mm256_andnot_si256(RankBit(highPair), ranks)), 4), _mm256_set1_epi32(0xFFF0));
+            best = _mm256_max_epu32(best, Where(pairsPlus, _mm256_or_si256(_mm256_set1_epi32(tables.typeBits[1]),
+                _mm256_or_si256(_mm256_slli_epi32(highPair, 16), pairKickers))));
+
+            // High card
+            best = _mm256_max_epu32(best, _mm256_or_si256(_mm256_set1_epi32(tables.typeBits[0]), Gather(tables.topFive, ranks)));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(strengths + i), best);
+        }
+        return i;
+    }
+}
+
+#else
+
+namespace Poker {
+    const bool BatchKernels::AVX2_COMPILED = false;
+
+    std::size_t BatchKernels::EvaluateAvx2(const Tables&, const std::uint16_t* const[4], std::size_t, std::uint32_t*) {
+        return 0;
+    }
+}
+
+#endif
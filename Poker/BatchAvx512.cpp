@@ -0,0 +1,109 @@
+#include "BatchKernels.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace Poker {
+    namespace {
+        inline __m512i Gather(const std::uint32_t* table, __m512i index) {
+            return _mm512_i32gather_epi32(index, table, 4);
+        }
+
+        // 1 << (rank - TWO), shifts of rank 0 fall out of range and give 0
+        inline __m512i RankBit(__m512i rank) {
+            return _mm512_sllv_epi32(_mm512_set1_epi32(1), _mm512_sub_epi32(rank, _mm512_set1_epi32(2)));
+        }
+
+        // value where condition is non zero, 0 elsewhere
+        inline __m512i Where(__m512i condition, __m512i value) {
+            return _mm512_maskz_mov_epi32(_mm512_test_epi32_mask(condition, condition), value);
+        }
+
+        inline __m512i Load(const std::uint16_t* suit) {
+            return _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(suit)));
+        }
+    }
+
+    // ----------------------------   Public   ----------------------------
+    const bool BatchKernels::AVX512_COMPILED = true;
+
+    // Every category that is present is scored without branches, the best hand is the largest of them
+    std::size_t BatchKernels::EvaluateAvx512(const Tables& tables, const std::uint16_t* const suits[4], std::size_t count, std::uint32_t* strengths) {
+        const std::size_t LANES = 16;
+
+        std::size_t i = 0;
+        for (; i + LANES <= count; i += LANES) {
+            const __m512i clubs = Load(suits[0] + i);
+            const __m512i diamonds = Load(suits[1] + i);
+            const __m512i hearts = Load(suits[2] + i);
+            const __m512i spades = Load(suits[3] + i);
+
+            const __m512i clubsDiamonds = _mm512_and_si512(clubs, diamonds);
+            const __m512i heartsSpades = _mm512_and_si512(hearts, spades);
+            const __m512i ranks = _mm512_or_si512(_mm512_or_si512(clubs, diamonds), _mm512_or_si512(hearts, spades));
+            const __m512i quads = _mm512_and_si512(clubsDiamonds, heartsSpades);
+            const __m512i tripsPlus = _mm512_or_si512(
+                _mm512_and_si512(clubsDiamonds, _mm512_or_si512(hearts, spades)),
+                _mm512_and_si512(heartsSpades, _mm512_or_si512(clubs, diamonds)));
+            const __m512i pairsPlus = _mm512_or_si512(
+                _mm512_or_si512(clubsDiamonds, heartsSpades),
+                _mm512_and_si512(_mm512_or_si512(clubs, diamonds), _mm512_or_si512(hearts, spades)));
+
+            // Flushes, zero unless the suit holds five cards
+            __m512i best = _mm512_max_epu32(
+                _mm512_max_epu32(Gather(tables.flushes, clubs), Gather(tables.flushes, diamonds)),
+                _mm512_max_epu32(Gather(tables.flushes, hearts), Gather(tables.flushes, spades)));
+
+            // Four of a kind
+            const __m512i quad = Gather(tables.topCard, quads);
+            const __m512i quadKicker = Gather(tables.topCard, _mm512_andnot_si512(RankBit(quad), ranks));
+            best = _mm512_max_epu32(best, Where(quads, _mm512_or_si512(_mm512_set1_epi32(tables.typeBits[7]),
+                _mm512_or_si512(_mm512_slli_epi32(quad, 16), _mm512_slli_epi32(quadKicker, 12)))));
+
+            // Full house
+            const __m512i trip = Gather(tables.topCard, tripsPlus);
+            const __m512i fullHousePair = _mm512_andnot_si512(RankBit(trip), pairsPlus);
+            best = _mm512_max_epu32(best, Where(tripsPlus, Where(fullHousePair, _mm512_or_si512(_mm512_set1_epi32(tables.typeBits[6]),
+                _mm512_or_si512(_mm512_slli_epi32(trip, 16), _mm512_slli_epi32(Gather(tables.topCard, fullHousePair), 12))))));
+
+            // Straight
+            const __m512i straight = Gather(tables.straights, ranks);
+            best = _mm512_max_epu32(best, Where(straight, _mm512_or_si512(_mm512_set1_epi32(tables.typeBits[4]), _mm512_slli_epi32(straight, 16))));
+
+            // Three of a kind
+            const __m512i tripKickers = _mm512_and_si512(_mm512_srli_epi32(Gather(tables.topFive, _mm512_andnot_si512(RankBit(trip), ranks)), 4), _mm512_set1_epi32(0xFF00));
+            best = _mm512_max_epu32(best, Where(tripsPlus, _mm512_or_si512(_mm512_set1_epi32(tables.typeBits[3]),
+                _mm512_or_si512(_mm512_slli_epi32(trip, 16), tripKickers))));
+
+            // Two pair
+            const __m512i highPair = Gather(tables.topCard, pairsPlus);
+            const __m512i lowPair = Gather(tables.topCard, _mm512_andnot_si512(RankBit(highPair), pairsPlus));
+            const __m512i twoPairKicker = Gather(tables.topCard, _mm512_andnot_si512(_mm512_or_si512(RankBit(highPair), RankBit(lowPair)), ranks));
+            best = _mm512_max_epu32(best, Where(lowPair, _mm512_or_si512(_mm512_set1_epi32(tables.typeBits[2]),
+                _mm512_or_si512(_mm512_or_si512(_mm512_slli_epi32(highPair, 16), _mm512_slli_epi32(lowPair, 12)), _mm512_slli_epi32(twoPairKicker, 8)))));
+
+            // Pair
+            const __m512i pairKickers = _mm512_and_si512(_mm512_srli_epi32(Gather(tables.topFive, _mm512_andnot_si512(RankBit(highPair), ranks)), 4), _mm512_set1_epi32(0xFFF0));
+            best = _mm512_max_epu32(best, Where(pairsPlus, _mm512_or_si512(_mm512_set1_epi32(tables.typeBits[1]),
+                _mm512_or_si512(_mm512_slli_epi32(highPair, 16), pairKickers))));
+
+            // High card
+            best = _mm512_max_epu32(best, _mm512_or_si512(_mm512_set1_epi32(tables.typeBits[0]), Gather(tables.topFive, ranks)));
+
+            _mm512_storeu_si512(strengths + i, best);
+        }
+        return i;
+    }
+}
+
+#else
+
+namespace Poker {
+    const bool BatchKernels::AVX512_COMPILED = false;
+
+    std::size_t BatchKernels::EvaluateAvx512(const Tables&, const std::uint16_t* const[4], std::size_t, std::uint32_t*) {
+        return 0;
+    }
+}
+
+#endif
@@ -0,0 +1,113 @@
+#include "BatchEvaluator.h"
+#include "BatchKernels.h"
+#include "Evaluator.h"
+#include "EvaluatorTables.h"
+#include "Hand.h"
+#include "Instrument.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Poker {
+    // ----------------------------   Public   ----------------------------
+    void BatchEvaluator::Hands::Add(CardSet hand) {
+        for (int suit = static_cast<int>(Card::Suit::CLUBS); suit <= static_cast<int>(Card::Suit::SPADES); suit++) {
+            suits[suit].push_back(hand.Suit(static_cast<Card::Suit>(suit)));
+        }
+    }
+
+    void BatchEvaluator::Hands::Clear() {
+        for (auto& suit : suits) {
+            suit.clear();
+        }
+    }
+
+    std::size_t BatchEvaluator::Hands::Size() const {
+        return suits[0].size();
+    }
+
+    void BatchEvaluator::Evaluate(const Hands& hands, std::uint32_t* strengths) {
+        const std::uint16_t* suits[Card::SUIT_COUNT] = { hands.suits[0].data(), hands.suits[1].data(), hands.suits[2].data(), hands.suits[3].data() };
+        Evaluate(suits, hands.Size(), strengths);
+    }
+
+    void BatchEvaluator::Evaluate(const std::uint16_t* const suits[Card::SUIT_COUNT], std::size_t count, std::uint32_t* strengths) {
+        static const Path PATH = DetectPath();
+        static const BatchKernels::Tables TABLES = [] {
+            BatchKernels::Tables tables = { EvaluatorTables::TOP_CARD_WIDE.data(), EvaluatorTables::TOP_FIVE.data(), EvaluatorTables::STRAIGHTS_WIDE.data(), EvaluatorTables::FLUSHES.data(), {} };
+            for (int type = static_cast<int>(Hand::Type::HIGH_CARD); type <= static_cast<int>(Hand::Type::STRAIGHT_FLUSH); type++) {
+                tables.typeBits[type] = EvaluatorTables::TypeBits(static_cast<Hand::Type>(type));
+            }
+            return tables;
+        }();
+
+        std::size_t done = 0;
+        switch (PATH) {
+        case Path::AVX512:
+            done = BatchKernels::EvaluateAvx512(TABLES, suits, count, strengths);
+            break;
+        case Path::AVX2:
+            done = BatchKernels::EvaluateAvx2(TABLES, suits, count, strengths);
+            break;
+        case Path::SCALAR:
+            break;
+        }
+
+        for (std::size_t i = done; i < count; i++) {
+            std::uint64_t mask = 0;
+            for (int suit = 0; suit < Card::SUIT_COUNT; suit++) {
+                mask |= static_cast<std::uint64_t>(suits[suit][i]) << (suit * Card::RANK_COUNT);
+            }
+            strengths[i] = Evaluator::Evaluate(CardSet(mask));
+        }
+        if constexpr (Instrument::ENABLED) {
+            for (std::size_t i = 0; i < done; i++) {
+                Instrument::Evaluated(Evaluator::TypeOf<Evaluator::StandardRules>(strengths[i]));
+            }
+        }
+    }
+
+    const char* BatchEvaluator::Implementation() {
+        switch (DetectPath()) {
+        case Path::AVX512:
+            return "avx512";
+        case Path::AVX2:
+            return "avx2";
+        default:
+            return "scalar";
+        }
+    }
+
+    // ----------------------------  Private  ----------------------------
+    BatchEvaluator::Path BatchEvaluator::DetectPath() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        bool avx512 = __builtin_cpu_supports("avx512f");
+        bool avx2 = __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        unsigned long long enabledState = osxsave ? _xgetbv(0) : 0;
+        int extended[4] = {};
+        if (maxLeaf >= 7) {
+            __cpuidex(extended, 7, 0);
+        }
+        bool avx512 = (enabledState & 0xE6) == 0xE6 && (extended[1] & (1 << 16));
+        bool avx2 = (enabledState & 0x06) == 0x06 && (extended[1] & (1 << 5));
+#else
+        bool avx512 = false;
+        bool avx2 = false;
+#endif
+        if (avx512 && BatchKernels::AVX512_COMPILED) {
+            return Path::AVX512;
+        }
+        if (avx2 && BatchKernels::AVX2_COMPILED) {
+            return Path::AVX2;
+        }
+        return Path::SCALAR;
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef BATCHEVALUATOR_H
+#define BATCHEVALUATOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Card.h"
+#include "CardSet.h"
+
+namespace Poker {
+    // Evaluates many independent hands at once, with the same strengths as Evaluator::Evaluate
+    // Uses AVX-512 (16 hands per step) or AVX2 (8 hands per step) when the CPU has them, scalar code otherwise
+    class BatchEvaluator {
+    public:
+        // Structure of arrays, suits[s][i] is the rank mask (CardSet::Suit) of suit s in hand i
+        struct Hands {
+            std::vector<std::uint16_t> suits[Card::SUIT_COUNT];
+
+            void Add(CardSet hand);
+            void Clear();
+            std::size_t Size() const;
+        };
+
+        static void Evaluate(const Hands& hands, std::uint32_t* strengths);
+        static void Evaluate(const std::uint16_t* const suits[Card::SUIT_COUNT], std::size_t count, std::uint32_t* strengths);
+        static const char* Implementation();    // Name of the code path chosen for this CPU
+
+    private:
+        enum class Path { SCALAR, AVX2, AVX512 };
+
+        static Path DetectPath();
+    };
+}
+
+#endif
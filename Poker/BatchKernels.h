@@ -0,0 +1,30 @@
+#ifndef BATCHKERNELS_H
+#define BATCHKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Vector kernels behind BatchEvaluator, each built in its own translation unit with its instruction set enabled
+// Kept free of library headers so no inline function gets compiled with instructions the CPU may lack
+namespace Poker {
+    namespace BatchKernels {
+        // Evaluator tables widened to 32 bits for gathers
+        struct Tables {
+            const std::uint32_t* topCard;
+            const std::uint32_t* topFive;
+            const std::uint32_t* straights;
+            const std::uint32_t* flushes;
+            std::uint32_t typeBits[9];  // Hand::Type shifted into place, indexed by Hand::Type
+        };
+
+        // False when the build couldn't enable the instruction set for that kernel
+        extern const bool AVX2_COMPILED;
+        extern const bool AVX512_COMPILED;
+
+        // Each returns how many leading hands it evaluated (a multiple of its lane count), the caller finishes the rest
+        std::size_t EvaluateAvx2(const Tables& tables, const std::uint16_t* const suits[4], std::size_t count, std::uint32_t* strengths);
+        std::size_t EvaluateAvx512(const Tables& tables, const std::uint16_t* const suits[4], std::size_t count, std::uint32_t* strengths);
+    }
+}
+
+#endif
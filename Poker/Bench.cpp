@@ -0,0 +1,189 @@
+// Bench.cpp : Fixed seed micro-benchmarks for the evaluator, deck, showdown and equity engine.
+// Usage: PokerBench [output.json]
+//
+
+#include "BatchEvaluator.h"
+#include "CardSet.h"
+#include "Deck.h"
+#include "Equity.h"
+#include "Evaluator.h"
+#include "Hand.h"
+#include "Instrument.h"
+#include "Random.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    const std::uint64_t SEED = 0x5EED;
+    const std::size_t HAND_COUNT = 1 << 20;
+    const int REPEATS = 10;
+
+    struct Result {
+        std::string name;
+        std::uint64_t operations;
+        double seconds;
+    };
+
+    std::uint64_t checksum = 0; // Keeps results alive so the optimiser can't drop the work, and must match between runs
+
+    Result Time(std::string name, std::uint64_t operations, std::function<void()> work) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return { name, operations, elapsed.count() };
+    }
+
+    std::vector<Poker::CardSet> RandomHands(std::size_t cardsPerHand) {
+        Poker::Deck deck(Poker::Random(SEED, cardsPerHand));
+        std::vector<Poker::CardSet> hands = {};
+        for (std::size_t i = 0; i < HAND_COUNT; i++) {
+            deck.Reset();
+            Poker::CardSet hand = {};
+            for (std::size_t j = 0; j < cardsPerHand; j++) {
+                hand.Add(deck.Draw());
+            }
+            hands.push_back(hand);
+        }
+        return hands;
+    }
+
+    Result EvaluateHands(std::size_t cardsPerHand) {
+        auto hands = RandomHands(cardsPerHand);
+        return Time("evaluate_" + std::to_string(cardsPerHand) + "_cards", HAND_COUNT * REPEATS, [&hands] {
+            for (int repeat = 0; repeat < REPEATS; repeat++) {
+                for (auto& hand : hands) {
+                    checksum += Poker::Evaluator::Evaluate(hand);
+                }
+            }
+        });
+    }
+
+    Result EvaluateBatch() {
+        auto hands = RandomHands(7);
+        Poker::BatchEvaluator::Hands batch = {};
+        for (auto& hand : hands) {
+            batch.Add(hand);
+        }
+        std::vector<std::uint32_t> strengths(hands.size());
+        return Time(std::string("evaluate_7_cards_batch_") + Poker::BatchEvaluator::Implementation(), HAND_COUNT * REPEATS, [&batch, &strengths] {
+            for (int repeat = 0; repeat < REPEATS; repeat++) {
+                Poker::BatchEvaluator::Evaluate(batch, strengths.data());
+                checksum += strengths[repeat];
+            }
+        });
+    }
+
+    Result Shuffle() {
+        const std::uint64_t shuffles = 1 << 22;
+        Poker::Deck deck(SEED);
+        return Time("deck_shuffle", shuffles, [&deck] {
+            for (std::uint64_t i = 0; i < shuffles; i++) {
+                deck.Reset();
+                deck.Shuffle();
+            }
+            checksum += deck.Draw().Id();
+        });
+    }
+
+    Result Draw() {
+        const std::uint64_t deals = 1 << 24;
+        Poker::Deck deck(SEED);
+        return Time("deck_reset_draw_7", deals, [&deck] {
+            for (std::uint64_t i = 0; i < deals; i++) {
+                deck.Reset();
+                for (int j = 0; j < 7; j++) {
+                    checksum += deck.Draw().Id();
+                }
+            }
+        });
+    }
+
+    Result Showdown() {
+        Poker::Deck deck(SEED);
+        std::vector<Poker::Hand> hands(HAND_COUNT);
+        for (auto& hand : hands) {
+            deck.Reset();
+            hand.Draw(deck, 7);
+        }
+        return Time("hand_operator_less", (HAND_COUNT - 1) * REPEATS, [&hands] {
+            for (int repeat = 0; repeat < REPEATS; repeat++) {
+                for (std::size_t i = 1; i < hands.size(); i++) {
+                    checksum += hands[i - 1] < hands[i];
+                }
+            }
+        });
+    }
+
+    Poker::CardSet Cards(std::vector<Poker::Card> cards) {
+        return Poker::CardSet(cards);
+    }
+
+    Result Simulate() {
+        using Poker::Card;
+        const std::uint64_t trials = 10000000;
+        Poker::Equity equity({
+            Cards({ Card(Card::Rank::ACE, Card::Suit::CLUBS), Card(Card::Rank::ACE, Card::Suit::DIAMONDS) }),
+            Cards({ Card(Card::Rank::KING, Card::Suit::HEARTS), Card(Card::Rank::KING, Card::Suit::SPADES) }) });
+        return Time("equity_simulate_headsup", trials, [&equity, trials] {
+            checksum += equity.Simulate(trials, SEED).wins[0];
+        });
+    }
+
+    Result Enumerate() {
+        using Poker::Card;
+        Poker::Equity equity({
+            Cards({ Card(Card::Rank::ACE, Card::Suit::CLUBS), Card(Card::Rank::ACE, Card::Suit::DIAMONDS) }),
+            Cards({ Card(Card::Rank::KING, Card::Suit::HEARTS), Card(Card::Rank::KING, Card::Suit::SPADES) }) });
+        Result result = Time("equity_enumerate_headsup_preflop", 0, [&equity] {
+            checksum += equity.Enumerate().wins[0];
+        });
+        result.operations = 1712304; // C(48, 5) boards
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string outputPath = argc > 1 ? argv[1] : "bench.json";
+
+    std::vector<Result> results = {};
+    for (std::size_t cards : { 5, 6, 7 }) {
+        results.push_back(EvaluateHands(cards));
+    }
+    results.push_back(EvaluateBatch());
+    results.push_back(Shuffle());
+    results.push_back(Draw());
+    results.push_back(Showdown());
+    results.push_back(Simulate());
+    results.push_back(Enumerate());
+
+    std::ofstream json(outputPath);
+    json << std::fixed << "{\n  \"seed\": " << SEED << ",\n  \"checksum\": " << checksum << ",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        auto& result = results[i];
+        double perSecond = result.operations / result.seconds;
+        double nsPerOp = result.seconds * 1e9 / result.operations;
+
+        std::cout << std::left << std::setw(36) << result.name
+            << std::right << std::setw(14) << std::fixed << std::setprecision(0) << perSecond << " /s"
+            << std::setw(10) << std::setprecision(2) << nsPerOp << " ns\n";
+        json << "    { \"name\": \"" << result.name << "\", \"operations\": " << result.operations
+            << ", \"seconds\": " << std::setprecision(6) << result.seconds
+            << ", \"per_second\": " << std::setprecision(0) << perSecond
+            << ", \"ns_per_op\": " << std::setprecision(3) << nsPerOp << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    std::cout << "Checksum " << checksum << ", results written to " << outputPath << "\n";
+    if constexpr (Poker::Instrument::ENABLED) {
+        Poker::Instrument::Collect().Write(std::cout);
+    }
+
+    return 0;
+}
@@ -2,8 +2,6 @@
 
 namespace Poker {
     // ----------------------------   Public   ----------------------------
-    Card::Card(Rank rank, Suit suit) : rank(rank), suit(suit) {}
-
     std::map<Card::Rank, std::string> Card::RANK_NAMES = {
             { Rank::TWO, "Two" },
             { Rank::THREE, "Three" },
@@ -1,6 +1,7 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include <cstdint>
 #include <ostream>
 #include <string>
 #include <map>
@@ -32,13 +33,27 @@ namespace Poker {
             SPADES = 3
         };
 
+        static const int RANK_COUNT = 1 + static_cast<int>(Rank::ACE) - static_cast<int>(Rank::TWO);
+        static const int SUIT_COUNT = 1 + static_cast<int>(Suit::SPADES) - static_cast<int>(Suit::CLUBS);
+        static const int DECK_SIZE = RANK_COUNT * SUIT_COUNT;
+
         static std::map<Rank, std::string> RANK_NAMES;
         static std::map<Suit, std::string> SUIT_NAMES;
 
         Rank rank;
         Suit suit;
 
-        Card(Rank rank, Suit suit);
+        constexpr Card(Rank rank, Suit suit) : rank(rank), suit(suit) {}
+        static constexpr Card FromId(std::uint8_t id) {
+            return Card(static_cast<Rank>(id % RANK_COUNT + static_cast<int>(Rank::TWO)), static_cast<Suit>(id / RANK_COUNT));
+        }
+
+        // Compact id in [0, DECK_SIZE), also the card's bit in a CardSet
+        constexpr std::uint8_t Id() const {
+            return static_cast<std::uint8_t>(static_cast<int>(suit) * RANK_COUNT + static_cast<int>(rank) - static_cast<int>(Rank::TWO));
+        }
+
+        friend constexpr bool operator==(const Card& lhs, const Card& rhs) { return lhs.Id() == rhs.Id(); }
 
         friend std::ostream& operator<< (std::ostream& os, const Card& card);
     };
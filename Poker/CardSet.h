@@ -0,0 +1,69 @@
+#ifndef CARDSET_H
+#define CARDSET_H
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "Card.h"
+
+namespace Poker {
+    // Set of cards as a 64 bit bitboard, bit Card::Id() set for each card
+    // Suit s occupies bits [13 * s, 13 * s + 13), ranks ascending from TWO
+    class CardSet {
+    public:
+        static const std::uint16_t SUIT_MASK = (1 << Card::RANK_COUNT) - 1;
+
+        std::uint64_t mask;
+
+        constexpr CardSet() : mask(0) {}
+        constexpr explicit CardSet(std::uint64_t mask) : mask(mask) {}
+        constexpr CardSet(Card card) : mask(std::uint64_t(1) << card.Id()) {}
+        CardSet(const std::vector<Card>& cards) : mask(0) {
+            for (auto& card : cards) {
+                Add(card);
+            }
+        }
+
+        static constexpr CardSet FromId(std::uint8_t id) { return CardSet(std::uint64_t(1) << id); }
+        static constexpr CardSet FullDeck() { return CardSet((std::uint64_t(1) << Card::DECK_SIZE) - 1); }
+
+        constexpr bool Contains(Card card) const { return mask >> card.Id() & 1; }
+        constexpr bool Contains(CardSet other) const { return (mask & other.mask) == other.mask; }
+        constexpr bool Intersects(CardSet other) const { return (mask & other.mask) != 0; }
+        constexpr void Add(Card card) { mask |= std::uint64_t(1) << card.Id(); }
+        constexpr void Remove(Card card) { mask &= ~(std::uint64_t(1) << card.Id()); }
+        constexpr int Size() const { return std::popcount(mask); }
+        constexpr bool Empty() const { return mask == 0; }
+
+        // Rank mask of one suit, bit (rank - TWO) set for each card of that suit
+        constexpr std::uint16_t Suit(Card::Suit suit) const {
+            return static_cast<std::uint16_t>(mask >> (static_cast<int>(suit) * Card::RANK_COUNT) & SUIT_MASK);
+        }
+
+        // Lowest card in the set, set must not be empty
+        constexpr Card First() const { return Card::FromId(static_cast<std::uint8_t>(std::countr_zero(mask))); }
+
+        class Iterator {
+        public:
+            constexpr Iterator(std::uint64_t mask) : mask(mask) {}
+            constexpr Card operator*() const { return Card::FromId(static_cast<std::uint8_t>(std::countr_zero(mask))); }
+            constexpr Iterator& operator++() { mask &= mask - 1; return *this; }
+            constexpr bool operator!=(const Iterator& other) const { return mask != other.mask; }
+        private:
+            std::uint64_t mask;
+        };
+        constexpr Iterator begin() const { return Iterator(mask); }
+        constexpr Iterator end() const { return Iterator(0); }
+
+        constexpr CardSet& operator|=(CardSet other) { mask |= other.mask; return *this; }
+        constexpr CardSet& operator&=(CardSet other) { mask &= other.mask; return *this; }
+        constexpr CardSet& operator-=(CardSet other) { mask &= ~other.mask; return *this; }
+        friend constexpr CardSet operator|(CardSet lhs, CardSet rhs) { return CardSet(lhs.mask | rhs.mask); }
+        friend constexpr CardSet operator&(CardSet lhs, CardSet rhs) { return CardSet(lhs.mask & rhs.mask); }
+        friend constexpr CardSet operator-(CardSet lhs, CardSet rhs) { return CardSet(lhs.mask & ~rhs.mask); }
+        friend constexpr bool operator==(CardSet lhs, CardSet rhs) { return lhs.mask == rhs.mask; }
+    };
+}
+
+#endif
@@ -0,0 +1,545 @@
+#include "Cfr.h"
+#include "Evaluator.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace Poker {
+    namespace {
+        const std::size_t BOARD_SIZE = 5;
+        const std::size_t MIN_CHUNK = 64;   // Hands per thread, fewer isn't worth a thread
+
+        // Sum of a[i] * b[i] with independent partial sums, the loop otherwise waits on each addition
+        float Dot(const float* a, const float* b, std::size_t size) {
+            float sums[4] = {};
+            std::size_t i = 0;
+            for (; i + 4 <= size; i += 4) {
+                for (std::size_t k = 0; k < 4; k++) {
+                    sums[k] += a[i + k] * b[i + k];
+                }
+            }
+            for (; i < size; i++) {
+                sums[0] += a[i] * b[i];
+            }
+            return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        }
+
+        std::uint64_t Choose(std::uint64_t n, std::uint64_t k) {
+            std::uint64_t result = 1;
+            for (std::uint64_t i = 1; i <= k; i++) {
+                result = result * (n - k + i) / i;
+            }
+            return result;
+        }
+
+    }
+
+    // ----------------------------   Public   ----------------------------
+    CfrSolver::CfrSolver(const Config& config) : config(config), hands(), handCards(), priors(), equities(), nodes(), depth(0), regrets(), strategySums(), iterations(0) {
+        if (config.board.Size() < 3 || config.board.Size() > static_cast<int>(BOARD_SIZE) || !(config.board - CardSet::FullDeck()).Empty()) {
+            throw std::invalid_argument("Boards have 3 to 5 cards");
+        }
+        if (config.pot < 0 || config.stack <= 0 || config.minimumBet <= 0) {
+            throw std::invalid_argument("Pot, stack and minimum bet must be positive");
+        }
+
+        for (std::uint8_t high = 1; high < Card::DECK_SIZE; high++) {
+            for (std::uint8_t low = 0; low < high; low++) {
+                CardSet hole = CardSet::FromId(high) | CardSet::FromId(low);
+                if (!hole.Intersects(config.board)) {
+                    hands.push_back(hole);
+                    handCards.push_back({ low, high });
+                }
+            }
+        }
+        for (std::size_t player = 0; player < 2; player++) {
+            for (CardSet hole : hands) {
+                priors[player].push_back(static_cast<float>(config.ranges[player].Weight(hole)));
+            }
+            if (std::all_of(std::begin(priors[player]), std::end(priors[player]), [](float weight) { return weight <= 0.0f; })) {
+                throw std::invalid_argument("A range has no hands off the board");
+            }
+        }
+
+        Build(0, { 0, 0 }, { false, false }, 0);
+        std::size_t size = 0;
+        for (auto& node : nodes) {
+            node.offset = size;
+            size += node.kind == Kind::DECISION ? node.actionCount * hands.size() : 0;
+        }
+        regrets.assign(size, 0.0f);
+        strategySums.assign(size, 0.0f);
+        BuildEquities();
+    }
+
+    void CfrSolver::Train(std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; i++) {
+            // CFR+ with alternating updates, the average weighting iteration t by t
+            this->iterations++;
+            for (std::size_t player = 0; player < 2; player++) {
+                Run({ Mode::TRAIN, player, static_cast<float>(this->iterations), 0, 0, {}, regrets.data(), strategySums.data() });
+            }
+        }
+    }
+
+    std::uint64_t CfrSolver::Iterations() const {
+        return iterations;
+    }
+
+    std::size_t CfrSolver::InfoSets() const {
+        return std::count_if(std::begin(nodes), std::end(nodes), [](const Node& node) { return node.kind == Kind::DECISION; }) * hands.size();
+    }
+
+    double CfrSolver::Exploitability() const {
+        // Deals are weighted by both ranges, the two seats' best responses share the pot at best
+        std::array<float, Card::DECK_SIZE> perCard = {};
+        float total = 0.0f;
+        for (std::size_t i = 0; i < hands.size(); i++) {
+            total += priors[1][i];
+            perCard[handCards[i][0]] += priors[1][i];
+            perCard[handCards[i][1]] += priors[1][i];
+        }
+        double deals = 0.0;
+        for (std::size_t i = 0; i < hands.size(); i++) {
+            deals += priors[0][i] * Unblocked(priors[1].data(), i, perCard, total);
+        }
+
+        double bestResponses = 0.0;
+        for (std::size_t player = 0; player < 2; player++) {
+            bestResponses += Run({ Mode::BEST_RESPONSE, player, 0.0f, 0, 0, {}, nullptr, nullptr });
+        }
+        return (bestResponses / deals - config.pot) / 2;
+    }
+
+    void CfrSolver::Write(const std::string& path) const {
+        CfrStrategy::Header header = {};
+        std::memcpy(header.magic, CfrStrategy::MAGIC, sizeof(CfrStrategy::MAGIC));
+        header.version = CfrStrategy::VERSION;
+        header.hands = static_cast<std::uint32_t>(hands.size());
+        header.pot = config.pot;
+        header.stack = config.stack;
+        header.minimumBet = config.minimumBet;
+        header.board = config.board.mask;
+
+        std::vector<CfrStrategy::NodeRecord> records = {};
+        std::vector<float> probabilities = {};
+        for (const Node& node : nodes) {
+            if (node.kind != Kind::DECISION) {
+                continue;
+            }
+            CfrStrategy::NodeRecord record = {};
+            record.bets[0] = node.bets[0];
+            record.bets[1] = node.bets[1];
+            record.player = node.player;
+            record.actionCount = node.actionCount;
+            for (std::size_t a = 0; a < node.actionCount; a++) {
+                record.actions[a] = static_cast<std::uint8_t>(node.actions[a]);
+            }
+            record.offset = static_cast<std::uint32_t>(probabilities.size());
+            records.push_back(record);
+
+            probabilities.resize(probabilities.size() + node.actionCount * hands.size());
+            Strategy(strategySums, node, 0, hands.size(), probabilities.data() + record.offset);
+        }
+        header.nodes = static_cast<std::uint32_t>(records.size());
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (CardSet hole : hands) {
+            file.write(reinterpret_cast<const char*>(&hole.mask), sizeof(hole.mask));
+        }
+        file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(CfrStrategy::NodeRecord));
+        file.write(reinterpret_cast<const char*>(probabilities.data()), probabilities.size() * sizeof(float));
+        if (!file) {
+            throw std::runtime_error("Can't write strategy " + path);
+        }
+    }
+
+    // ----------------------------  Private  ----------------------------
+    std::uint32_t CfrSolver::Build(std::size_t player, std::array<int, 2> bets, std::array<bool, 2> acted, std::size_t level) {
+        depth = std::max(depth, level);
+        std::uint32_t index = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back({ Kind::DECISION, static_cast<std::uint8_t>(player), 0, {}, {}, bets, 0 });
+
+        std::size_t opponent = 1 - player;
+        int toCall = bets[opponent] - bets[player];
+        int cash = config.stack - bets[player];
+        std::array<bool, 2> actedNow = acted;
+        actedNow[player] = true;
+
+        auto add = [&](Game::Action action, std::uint32_t child) {
+            Node& node = nodes[index];
+            node.actions[node.actionCount] = action;
+            node.children[node.actionCount] = child;
+            node.actionCount++;
+        };
+
+        // As Game::Apply, a raise tops the current bet by minimumBet or puts the rest of the stack in
+        if (toCall > 0) {
+            std::uint32_t fold = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back({ Kind::FOLD, static_cast<std::uint8_t>(player), 0, {}, {}, bets, 0 });
+            add(Game::Action::FOLD, fold);
+        }
+        std::array<int, 2> called = bets;
+        called[player] += std::min(toCall, cash);
+        add(Game::Action::CALL, Next(player, called, actedNow, level));
+        if (cash > toCall && config.stack > bets[opponent]) {
+            std::array<int, 2> raised = bets;
+            raised[player] = std::min(bets[opponent] + config.minimumBet, config.stack);
+            add(Game::Action::RAISE, Next(player, raised, actedNow, level));
+        }
+        return index;
+    }
+
+    std::uint32_t CfrSolver::Next(std::size_t player, std::array<int, 2> bets, std::array<bool, 2> acted, std::size_t level) {
+        // Over once everyone with cash left has acted and matched the current bet, as in Game::BettingRound
+        int currentBet = std::max(bets[0], bets[1]);
+        bool done = true;
+        for (std::size_t seat = 0; seat < 2; seat++) {
+            if (config.stack > bets[seat] && (!acted[seat] || bets[seat] < currentBet)) {
+                done = false;
+            }
+        }
+        if (done) {
+            std::uint32_t index = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back({ Kind::SHOWDOWN, 0, 0, {}, {}, bets, 0 });
+            return index;
+        }
+        return Build(1 - player, bets, acted, level + 1);
+    }
+
+    void CfrSolver::BuildEquities() {
+        const std::size_t size = hands.size();
+        CardSet remaining = CardSet::FullDeck() - config.board;
+        std::vector<std::uint8_t> deck = {};
+        for (Card card : remaining) {
+            deck.push_back(card.Id());
+        }
+
+        // Every way to finish the board, at most two cards
+        std::vector<CardSet> runouts = {};
+        std::size_t needed = BOARD_SIZE - config.board.Size();
+        if (needed == 0) {
+            runouts.push_back({});
+        }
+        for (std::size_t first = 0; needed > 0 && first < deck.size(); first++) {
+            if (needed == 1) {
+                runouts.push_back(CardSet::FromId(deck[first]));
+                continue;
+            }
+            for (std::size_t second = first + 1; second < deck.size(); second++) {
+                runouts.push_back(CardSet::FromId(deck[first]) | CardSet::FromId(deck[second]));
+            }
+        }
+
+        // Hands blocked by a runout get a strength nothing ties or loses to, so they add nothing
+        const std::uint32_t BLOCKED = ~std::uint32_t(0);
+        std::vector<std::uint32_t> strengths(runouts.size() * size);
+        Parallel::ForRange(runouts.size(), Parallel::ThreadCount(config.threads), MIN_CHUNK, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r = begin; r < end; r++) {
+                CardSet board = config.board | runouts[r];
+                for (std::size_t i = 0; i < size; i++) {
+                    strengths[r * size + i] = hands[i].Intersects(runouts[r]) ? BLOCKED : Evaluator::Evaluate(hands[i] | board);
+                }
+            }
+        });
+
+        // Each pair of hands sees the same number of runouts, the cards left once both are dealt
+        const float share = 1.0f / static_cast<float>(Choose(deck.size() - 4, needed));
+        equities.assign(size * size, 0.0f);
+        Parallel::ForRange(size, Parallel::ThreadCount(config.threads), MIN_CHUNK, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r = 0; r < runouts.size(); r++) {
+                const std::uint32_t* strength = strengths.data() + r * size;
+                for (std::size_t i = begin; i < end; i++) {
+                    if (strength[i] == BLOCKED) {
+                        continue;
+                    }
+                    float* row = equities.data() + i * size;
+                    for (std::size_t j = 0; j < size; j++) {
+                        row[j] += (strength[i] > strength[j] ? 1.0f : 0.0f) + (strength[i] == strength[j] ? 0.5f : 0.0f);
+                    }
+                }
+            }
+            for (std::size_t i = begin; i < end; i++) {
+                for (std::size_t j = 0; j < size; j++) {
+                    equities[i * size + j] = hands[i].Intersects(hands[j]) ? 0.0f : equities[i * size + j] * share;
+                }
+            }
+        });
+    }
+
+    double CfrSolver::Run(const Pass& pass) const {
+        const std::size_t size = hands.size();
+        const std::size_t player = pass.player;
+        std::vector<float> values(size, 0.0f);
+        Parallel::ForRange(size, Parallel::ThreadCount(config.threads), MIN_CHUNK, [&](std::size_t begin, std::size_t end) {
+            Pass chunk = pass;
+            chunk.begin = begin;
+            chunk.end = end;
+            chunk.scratch.assign((depth + 1) * (2 * MAX_ACTIONS + 1) * size, 0.0f);
+            Walk(chunk, 0, 0, priors[player].data(), priors[1 - player].data(), values.data());
+        });
+
+        double total = 0.0;
+        for (std::size_t i = 0; i < size; i++) {
+            total += static_cast<double>(priors[player][i]) * values[i];
+        }
+        return total;
+    }
+
+    void CfrSolver::Walk(Pass& pass, std::uint32_t index, std::size_t level, const float* own, const float* opponent, float* values) const {
+        const Node& node = nodes[index];
+        if (node.kind != Kind::DECISION) {
+            Terminal(pass, node, opponent, values);
+            return;
+        }
+
+        const std::size_t size = hands.size();
+        const std::size_t count = node.actionCount;
+        float* strategy = pass.scratch.data() + level * (2 * MAX_ACTIONS + 1) * size;
+        float* reach = strategy + MAX_ACTIONS * size;
+        float* childValues = reach + size;
+
+        if (node.player != pass.player) {
+            // Opponent's hands all carry on down each action, weighted by how often they take it
+            Strategy(pass.mode == Mode::TRAIN ? regrets : strategySums, node, 0, size, strategy);
+            std::fill(values + pass.begin, values + pass.end, 0.0f);
+            for (std::size_t a = 0; a < count; a++) {
+                for (std::size_t j = 0; j < size; j++) {
+                    reach[j] = opponent[j] * strategy[a * size + j];
+                }
+                Walk(pass, node.children[a], level + 1, own, reach, childValues);
+                for (std::size_t i = pass.begin; i < pass.end; i++) {
+                    values[i] += childValues[i];
+                }
+            }
+            return;
+        }
+
+        if (pass.mode == Mode::BEST_RESPONSE) {
+            for (std::size_t a = 0; a < count; a++) {
+                Walk(pass, node.children[a], level + 1, own, opponent, childValues + a * size);
+            }
+            for (std::size_t i = pass.begin; i < pass.end; i++) {
+                values[i] = childValues[i];
+                for (std::size_t a = 1; a < count; a++) {
+                    values[i] = std::max(values[i], childValues[a * size + i]);
+                }
+            }
+            return;
+        }
+
+        Strategy(regrets, node, pass.begin, pass.end, strategy);
+        for (std::size_t a = 0; a < count; a++) {
+            for (std::size_t i = pass.begin; i < pass.end; i++) {
+                reach[i] = own[i] * strategy[a * size + i];
+            }
+            Walk(pass, node.children[a], level + 1, reach, opponent, childValues + a * size);
+        }
+        std::fill(values + pass.begin, values + pass.end, 0.0f);
+        for (std::size_t a = 0; a < count; a++) {
+            for (std::size_t i = pass.begin; i < pass.end; i++) {
+                values[i] += strategy[a * size + i] * childValues[a * size + i];
+            }
+        }
+
+        // CFR+ floors regrets at zero, so an action that turns good is picked up straight away
+        float* regret = pass.regrets + node.offset;
+        float* sum = pass.strategySums + node.offset;
+        for (std::size_t a = 0; a < count; a++) {
+            for (std::size_t i = pass.begin; i < pass.end; i++) {
+                regret[a * size + i] = std::max(regret[a * size + i] + childValues[a * size + i] - values[i], 0.0f);
+                sum[a * size + i] += pass.weight * own[i] * strategy[a * size + i];
+            }
+        }
+    }
+
+    void CfrSolver::Terminal(const Pass& pass, const Node& node, const float* opponent, float* values) const {
+        // Opponent reach the updating player's hand doesn't block, from per card sums
+        std::array<float, Card::DECK_SIZE> perCard = {};
+        float total = 0.0f;
+        for (std::size_t j = 0; j < hands.size(); j++) {
+            total += opponent[j];
+            perCard[handCards[j][0]] += opponent[j];
+            perCard[handCards[j][1]] += opponent[j];
+        }
+
+        // Chips won back from the round, relative to the player's stack when it started
+        const float pot = static_cast<float>(config.pot + node.bets[0] + node.bets[1]);
+        const float own = static_cast<float>(node.bets[pass.player]);
+        for (std::size_t i = pass.begin; i < pass.end; i++) {
+            float unblocked = Unblocked(opponent, i, perCard, total);
+            if (node.kind == Kind::FOLD) {
+                values[i] = (node.player == pass.player ? -own : pot - own) * unblocked;
+            }
+            else {
+                values[i] = pot * Dot(equities.data() + i * hands.size(), opponent, hands.size()) - own * unblocked;
+            }
+        }
+    }
+
+    void CfrSolver::Strategy(const std::vector<float>& arena, const Node& node, std::size_t begin, std::size_t end, float* strategy) const {
+        // Proportional to the positive entries, uniform when there are none
+        const std::size_t size = hands.size();
+        const float* entries = arena.data() + node.offset;
+        for (std::size_t i = begin; i < end; i++) {
+            float sum = 0.0f;
+            for (std::size_t a = 0; a < node.actionCount; a++) {
+                sum += std::max(entries[a * size + i], 0.0f);
+            }
+            for (std::size_t a = 0; a < node.actionCount; a++) {
+                strategy[a * size + i] = sum > 0.0f ? std::max(entries[a * size + i], 0.0f) / sum : 1.0f / node.actionCount;
+            }
+        }
+    }
+
+    float CfrSolver::Unblocked(const float* reach, std::size_t hand, const std::array<float, Card::DECK_SIZE>& perCard, float total) const {
+        // The hand itself was taken off twice, once per card
+        return total - perCard[handCards[hand][0]] - perCard[handCards[hand][1]] + reach[hand];
+    }
+
+    // ----------------------------   Public   ----------------------------
+    const char CfrStrategy::MAGIC[8] = { 'C', 'F', 'R', 'P', 'L', 'U', 'S', '\0' };
+
+    CfrStrategy::CfrStrategy(std::uint64_t seed) : subgames(), random(seed) {}
+
+    void CfrStrategy::Load(const std::string& path) {
+        Subgame subgame = { std::make_unique<MappedFile>(path), nullptr, nullptr, nullptr, nullptr, {} };
+        const unsigned char* data = subgame.file->Data();
+        std::size_t size = subgame.file->Size();
+
+        subgame.header = reinterpret_cast<const Header*>(data);
+        const Header& header = *subgame.header;
+        bool valid = size >= sizeof(Header) && std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION;
+
+        // Everything Act divides by, indexes with or casts has to be checked, not just the sizes
+        CardSet board(valid ? header.board : 0);
+        valid = valid && header.hands > 0 && header.nodes > 0 && header.minimumBet > 0 && header.stack > 0 && header.pot >= 0
+            && (board - CardSet::FullDeck()).Empty() && board.Size() >= 3 && board.Size() <= 5;
+        std::uint64_t tables = sizeof(Header) + std::uint64_t(valid ? header.hands : 0) * sizeof(std::uint64_t) + std::uint64_t(valid ? header.nodes : 0) * sizeof(NodeRecord);
+        valid = valid && size >= tables && (size - tables) % sizeof(float) == 0;
+        std::uint64_t probabilities = valid ? (size - tables) / sizeof(float) : 0;
+        if (valid) {
+            subgame.hands = reinterpret_cast<const std::uint64_t*>(data + sizeof(Header));
+            subgame.nodes = reinterpret_cast<const NodeRecord*>(subgame.hands + header.hands);
+            subgame.probabilities = reinterpret_cast<const float*>(subgame.nodes + header.nodes);
+        }
+        for (std::uint32_t h = 0; valid && h < header.hands; h++) {
+            // Two card holdings off the board in ascending order, Act binary searches them
+            CardSet hole(subgame.hands[h]);
+            valid = (hole - CardSet::FullDeck()).Empty() && hole.Size() == 2 && !hole.Intersects(board) && (h == 0 || subgame.hands[h - 1] < hole.mask);
+        }
+        for (std::uint32_t n = 0; valid && n < header.nodes; n++) {
+            const NodeRecord& node = subgame.nodes[n];
+            valid = node.player < 2 && node.actionCount >= 1 && node.actionCount <= 3
+                && node.offset + std::uint64_t(node.actionCount) * header.hands <= probabilities;
+            for (std::size_t a = 0; valid && a < node.actionCount; a++) {
+                valid = node.actions[a] <= static_cast<std::uint8_t>(Game::Action::RAISE);
+            }
+        }
+        if (!valid) {
+            throw std::runtime_error("Not a strategy, or written by a different version: " + path);
+        }
+
+        for (std::uint32_t h = 0; h < header.hands; h++) {
+            subgame.strengths.push_back({ Strength(CardSet(subgame.hands[h]), board), h });
+        }
+        std::sort(std::begin(subgame.strengths), std::end(subgame.strengths));
+
+        auto same = std::find_if(std::begin(subgames), std::end(subgames),
+            [&](const Subgame& loaded) { return CardSet(loaded.header->board).Size() == board.Size(); });
+        if (same != std::end(subgames)) {
+            *same = std::move(subgame);
+        }
+        else {
+            subgames.push_back(std::move(subgame));
+        }
+    }
+
+    Game::Action CfrStrategy::Act(const Game& game, std::size_t seat) {
+        CardSet board = game.Board().Cards();
+        auto subgame = std::find_if(std::begin(subgames), std::end(subgames),
+            [&](const Subgame& loaded) { return CardSet(loaded.header->board).Size() == board.Size(); });
+        if (game.CurrentStreet() == Game::Street::PRE_FLOP || subgame == std::end(subgames)) {
+            return Game::Action::CALL;
+        }
+
+        // Heads-up, the first seat left after the button acts first
+        std::size_t live = 0;
+        std::size_t opponent = seat;
+        for (std::size_t i = 0; i < game.Players(); i++) {
+            if (game.InRound(i) && i != seat) {
+                live++;
+                opponent = i;
+            }
+        }
+        if (live != 1) {
+            return Game::Action::CALL;
+        }
+        std::size_t first = (game.Button() + 1) % game.Players();
+        while (!game.InRound(first)) {
+            first = (first + 1) % game.Players();
+        }
+        std::size_t player = seat == first ? 0 : 1;
+
+        // Bets are matched in units of the minimum bet, so a solve transfers to other blinds
+        auto units = [](int bet, int minimumBet) { return (2 * bet + minimumBet) / (2 * minimumBet); };
+        int ownUnits = units(game.Bet(seat), game.MinimumBet());
+        int opponentUnits = units(game.Bet(opponent), game.MinimumBet());
+        const Header& header = *subgame->header;
+        const NodeRecord* node = nullptr;
+        for (std::uint32_t n = 0; n < header.nodes && !node; n++) {
+            const NodeRecord& record = subgame->nodes[n];
+            if (record.player == player && units(record.bets[player], header.minimumBet) == ownUnits
+                && units(record.bets[1 - player], header.minimumBet) == opponentUnits) {
+                node = &record;
+            }
+        }
+        if (!node) {
+            return Game::Action::CALL;
+        }
+
+        CardSet hole = game.Hole(seat).Cards();
+        std::size_t hand = std::lower_bound(subgame->hands, subgame->hands + header.hands, hole.mask) - subgame->hands;
+        if (board != CardSet(header.board) || hand == header.hands || subgame->hands[hand] != hole.mask) {
+            float strength = Strength(hole, board);
+            auto& strengths = subgame->strengths;
+            auto above = std::lower_bound(std::begin(strengths), std::end(strengths), std::make_pair(strength, std::uint32_t(0)));
+            if (above == std::end(strengths) || (above != std::begin(strengths) && above->first - strength > strength - (above - 1)->first)) {
+                above--;
+            }
+            hand = above->second;
+        }
+
+        float pick = static_cast<float>(random() >> 40) / static_cast<float>(1 << 24);
+        for (std::size_t a = 0; a + 1 < node->actionCount; a++) {
+            pick -= subgame->probabilities[node->offset + a * header.hands + hand];
+            if (pick < 0.0f) {
+                return static_cast<Game::Action>(node->actions[a]);
+            }
+        }
+        return static_cast<Game::Action>(node->actions[node->actionCount - 1]);
+    }
+
+    // ----------------------------  Private  ----------------------------
+    float CfrStrategy::Strength(CardSet hole, CardSet board) {
+        std::uint32_t own = Evaluator::Evaluate(hole | board);
+        CardSet remaining = CardSet::FullDeck() - hole - board;
+        double score = 0.0;
+        std::size_t opponents = 0;
+        for (Card high : remaining) {
+            for (Card low : remaining) {
+                if (low.Id() >= high.Id()) {
+                    break;
+                }
+                std::uint32_t strength = Evaluator::Evaluate(CardSet(high) | CardSet(low) | board);
+                score += own > strength ? 1.0 : own == strength ? 0.5 : 0.0;
+                opponents++;
+            }
+        }
+        return static_cast<float>(score / opponents);
+    }
+}
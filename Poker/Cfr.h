@@ -0,0 +1,164 @@
+#ifndef CFR_H
+#define CFR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CardSet.h"
+#include "Game.h"
+#include "MappedFile.h"
+#include "Random.h"
+#include "Range.h"
+
+namespace Poker {
+    // CFR+ solver for one heads-up Game::BettingRound after the flop on a fixed board, the same FOLD, CALL and RAISE by
+    // minimumBet (capped at the stack) the game plays, except that nobody folds when there's nothing to call
+    // Every hand of both players is walked at once: one pass over the public betting tree per player per iteration,
+    // with a vector of values per node. Regrets and strategy sums live in two flat arenas, node by node, one contiguous
+    // run of hands per action. Passes are split across threads by the updating player's hands, which touch disjoint entries
+    // Showdowns on a short board pay each player's all-in equity over the remaining cards, later betting isn't modelled
+    class CfrSolver {
+    public:
+        struct Config {
+            CardSet board;                      // 3 to 5 cards
+            int pot = Game::STARTING_CASH / 3;  // Collected before this round, the blinds of a called preflop by default
+            int stack = Game::STARTING_CASH - Game::STARTING_CASH / 6;  // Each player's cash at the start of the round
+            int minimumBet = Game::STARTING_CASH / 6;
+            std::array<Range, 2> ranges = { Range::Full(), Range::Full() };    // First to act, then the button
+            unsigned threads = 0;               // 0 for all cores
+        };
+
+        // Throws std::invalid_argument for a bad board, amounts or a range with nothing left off the board
+        explicit CfrSolver(const Config& config);
+
+        void Train(std::uint64_t iterations);   // Continues from earlier calls
+        std::uint64_t Iterations() const;
+        std::size_t InfoSets() const;           // Decision nodes times hands
+
+        // How much a best response to the average strategy wins per hand, averaged over the two seats, in chips
+        double Exploitability() const;
+
+        // Average strategy for CfrStrategy, throws std::runtime_error if the file can't be written
+        void Write(const std::string& path) const;
+
+    private:
+        static const std::size_t MAX_ACTIONS = 3;
+
+        enum class Kind : std::uint8_t
+        {
+            DECISION,
+            FOLD,
+            SHOWDOWN
+        };
+        enum class Mode
+        {
+            TRAIN,                              // Updating player's regrets and strategy sums against the current strategy
+            BEST_RESPONSE                       // Updating player maximises against the average strategy, nothing is written
+        };
+
+        struct Node {
+            Kind kind;
+            std::uint8_t player;                // To act, or who folded
+            std::uint8_t actionCount;
+            std::array<Game::Action, MAX_ACTIONS> actions;
+            std::array<std::uint32_t, MAX_ACTIONS> children;
+            std::array<int, 2> bets;            // Put in during this round
+            std::size_t offset;                 // Into the arenas, actionCount runs of hands
+        };
+
+        // One thread's share of a pass, the updating player's hands [begin, end)
+        struct Pass {
+            Mode mode;
+            std::size_t player;
+            float weight;
+            std::size_t begin;
+            std::size_t end;
+            std::vector<float> scratch;         // Per tree depth: strategy, child reach and child values
+            float* regrets;                     // Written by TRAIN passes only
+            float* strategySums;
+        };
+
+        Config config;
+        std::vector<CardSet> hands;             // Holdings off the board, ascending, the same list for both players
+        std::vector<std::array<std::uint8_t, 2>> handCards;
+        std::array<std::vector<float>, 2> priors;   // Range weights per hand
+        std::vector<float> equities;            // hands x hands, 0 where the hands share a card
+        std::vector<Node> nodes;                // Root first
+        std::size_t depth;                      // Deepest decision node, the root at 0
+        std::vector<float> regrets;
+        std::vector<float> strategySums;
+        std::uint64_t iterations;
+
+        std::uint32_t Build(std::size_t player, std::array<int, 2> bets, std::array<bool, 2> acted, std::size_t level);
+        std::uint32_t Next(std::size_t player, std::array<int, 2> bets, std::array<bool, 2> acted, std::size_t level);
+        void BuildEquities();
+
+        double Run(const Pass& pass) const;     // Sum of the player's root values weighted by its range
+        void Walk(Pass& pass, std::uint32_t index, std::size_t level, const float* own, const float* opponent, float* values) const;
+        void Terminal(const Pass& pass, const Node& node, const float* opponent, float* values) const;
+        void Strategy(const std::vector<float>& arena, const Node& node, std::size_t begin, std::size_t end, float* strategy) const;
+        float Unblocked(const float* reach, std::size_t hand, const std::array<float, Card::DECK_SIZE>& perCard, float total) const;
+    };
+
+    // Plays a strategy file written by CfrSolver from the seats it's given, heads-up after the flop
+    // Anything the files don't cover (preflop, more than two players left, streets with no file, a betting line
+    // outside the solved tree) is called like the default strategy does
+    // On a different board than the one solved, a hand plays like the solved hand nearest it in strength against a random hand
+    class CfrStrategy : public Game::Strategy {
+    public:
+        explicit CfrStrategy(std::uint64_t seed = 0);
+
+        // Used on streets with as many board cards as it was solved for, replacing any earlier file for that street
+        // Throws std::runtime_error if the file can't be mapped or wasn't written by a matching CfrSolver
+        void Load(const std::string& path);
+
+        Game::Action Act(const Game& game, std::size_t seat) override;
+
+    private:
+        friend class CfrSolver;
+
+        // Native byte order: the header, hand masks, decision nodes, then each node's probabilities action by action
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t hands;
+            std::uint32_t nodes;
+            std::int32_t pot;
+            std::int32_t stack;
+            std::int32_t minimumBet;
+            std::uint64_t board;
+        };
+        struct NodeRecord {
+            std::int32_t bets[2];
+            std::uint8_t player;                // 0 first to act, 1 the button
+            std::uint8_t actionCount;
+            std::uint8_t actions[3];            // Game::Action
+            std::uint8_t padding[3];
+            std::uint32_t offset;               // Into the probabilities
+        };
+
+        static const std::uint32_t VERSION = 1;
+        static const char MAGIC[8];
+
+        struct Subgame {
+            std::unique_ptr<MappedFile> file;
+            const Header* header;
+            const std::uint64_t* hands;
+            const NodeRecord* nodes;
+            const float* probabilities;
+            std::vector<std::pair<float, std::uint32_t>> strengths;    // Hand strength on the solved board, ascending
+        };
+
+        std::vector<Subgame> subgames;
+        Random random;
+
+        static float Strength(CardSet hole, CardSet board);     // Share of random hands it beats, ties counting half
+    };
+}
+
+#endif
@@ -0,0 +1,104 @@
+// CfrTool.cpp : Solves a heads-up betting round on a board and writes the strategy CfrStrategy plays.
+// Usage: CfrTool output.bin board [iterations = 1000] [threads = 0] [first to act range] [button range]
+//
+// The board is 3 to 5 cards like "Ah7d2c", ranges are Range::Parse notation and default to every hand.
+// Pot, stacks and the minimum bet are the game's after a called preflop, see CfrSolver::Config.
+// Exploitability is reported ten times along the way, in chips per hand and as a share of the pot.
+
+#include "Cfr.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    using Poker::Card;
+    using Poker::CardSet;
+
+    Poker::CardSet ParseBoard(const std::string& text) {
+        const std::string RANKS = "23456789TJQKA";
+        const std::string SUITS = "cdhs";
+        CardSet board = {};
+        for (std::size_t i = 0; i + 1 < text.size(); i += 2) {
+            std::size_t rank = RANKS.find(static_cast<char>(std::toupper(static_cast<unsigned char>(text[i]))));
+            std::size_t suit = SUITS.find(static_cast<char>(std::tolower(static_cast<unsigned char>(text[i + 1]))));
+            if (rank == std::string::npos || suit == std::string::npos) {
+                throw std::invalid_argument("Not a board: " + text);
+            }
+            Card card(static_cast<Card::Rank>(rank + static_cast<std::size_t>(Card::Rank::TWO)), static_cast<Card::Suit>(suit));
+            if (board.Contains(card)) {
+                throw std::invalid_argument("Board repeats a card: " + text);
+            }
+            board.Add(card);
+        }
+        if (text.size() % 2 != 0) {
+            throw std::invalid_argument("Not a board: " + text);
+        }
+        return board;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        std::cerr << "Usage: CfrTool output.bin board [iterations = 1000] [threads = 0] [first to act range] [button range]\n";
+        return 1;
+    }
+    std::string outputPath = argv[1];
+    std::uint64_t iterations = 1000;
+
+    Poker::CfrSolver::Config config = {};
+    try {
+        iterations = argc > 3 ? std::stoull(argv[3]) : iterations;
+        config.threads = argc > 4 ? static_cast<unsigned>(std::stoul(argv[4])) : 0;
+    }
+    catch (const std::logic_error&) {           // std::stoul's invalid_argument and out_of_range
+        std::cerr << "Iterations and threads must be whole numbers\n";
+        return 1;
+    }
+    try {
+        config.board = ParseBoard(argv[2]);
+        for (std::size_t player = 0; player < 2 && argc > 5 + static_cast<int>(player); player++) {
+            config.ranges[player] = Poker::Range::Parse(argv[5 + player]);
+        }
+    }
+    catch (const std::invalid_argument& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto seconds = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+    std::unique_ptr<Poker::CfrSolver> solver = nullptr;
+    try {
+        solver = std::make_unique<Poker::CfrSolver>(config);
+    }
+    catch (const std::invalid_argument& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    std::cout << solver->InfoSets() << " information sets, equities ready after " << seconds() << " s\n";
+
+    std::uint64_t step = std::max<std::uint64_t>(iterations / 10, 1);
+    while (solver->Iterations() < iterations) {
+        solver->Train(std::min(step, iterations - solver->Iterations()));
+        double exploitability = solver->Exploitability();
+        std::cout << solver->Iterations() << " iterations, " << seconds() << " s, exploitability " << exploitability << " chips ("
+            << 100.0 * exploitability / config.pot << "% of the pot)\n";
+    }
+
+    try {
+        solver->Write(outputPath);
+    }
+    catch (const std::runtime_error& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    std::cout << "Strategy written to " << outputPath << "\n";
+
+    return 0;
+}
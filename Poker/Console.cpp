@@ -0,0 +1,118 @@
+#include "Console.h"
+#include "getch.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+
+
+
+namespace Poker {
+    // ----------------------------   Public   ----------------------------
+    Console::Console(std::size_t humanSeat) : humanSeat(humanSeat) {}
+
+    void Console::Start(Game& game) {
+        game.SetStrategy(humanSeat, *this);
+        game.SetListener(this);
+        while (GetInput("Play Round? ([Y]es, [N]o): ", { 'Y', 'N' }) != 'N') {
+            if (!game.PlayHand()) {
+                std::cout << "Player " << game.Winner() + 1 << " won the game!";
+                break;
+            }
+        }
+        game.SetListener(nullptr);
+    }
+
+    Game::Action Console::Act(const Game&, std::size_t) {
+        switch (GetInput("Enter an action ([F]old, [C]heck/[C]all, [R]aise): ", { 'F', 'C', 'R' })) {
+        case 'F':
+            return Game::Action::FOLD;
+        case 'R':
+            return Game::Action::RAISE;
+        default:
+            return Game::Action::CALL;
+        }
+    }
+
+    void Console::OnStreet(const Game& game) {
+        DrawTable(game);
+    }
+
+    void Console::OnTurn(const Game& game, std::size_t seat) {
+        // Display current bets
+        std::cout << "Current bets:" << "\n";
+        for (std::size_t i = 0; i < game.Players(); i++) {
+            if (game.InRound(i)) {
+                std::cout << "\t\b\b\b"
+                    << (i == game.SmallBlind() ? "b" : i == game.BigBlind() ? "B" : " ")
+                    << (i == seat ? ">" : " ")
+                    << " Player " << i + 1 << ": " << game.Bet(i) << "\n";
+            }
+        }
+    }
+
+    void Console::OnAction(const Game& game, std::size_t seat, Game::Action action, int) {
+        switch (action) {
+        case Game::Action::CALL:
+            std::cout << "Player " << seat + 1 << " Called" << "\n\n";
+            break;
+        case Game::Action::FOLD:
+            std::cout << "Player " << seat + 1 << " Folded" << "\n\n";
+            break;
+        case Game::Action::RAISE:
+            std::cout << "Player " << seat + 1 << " Raised to " << game.Bet(seat) << "\n\n";
+            break;
+        }
+        GetInput("Press space to continue...", { ' ' });
+    }
+
+    void Console::OnRefund(const Game&, std::size_t seat, int amount) {
+        std::cout << "Player " << seat + 1 << " takes back " << amount << " uncalled\n";
+    }
+
+    void Console::OnShowdown(const Game& game) {
+        for (std::size_t i = 0; i < game.Players(); i++) {
+            if (game.InRound(i)) {
+                std::cout << "Player " << i + 1 << " " << game.Hole(i) << "\n";
+            }
+        }
+        std::cout << "Community " << game.Board() << "\n";
+    }
+
+    void Console::OnWin(const Game& game, std::size_t seat, int amount) {
+        if (game.CurrentStreet() == Game::Street::SHOWDOWN) {
+            auto winningScore = Hand::Score(game.Strength(seat));
+            std::cout << "Player " << seat + 1 << " Wins " << amount << " with " << Hand::TYPE_NAMES[winningScore.first](winningScore.second) << "!\n=========================================\n";
+        }
+        else {
+            std::cout << "Player " << seat + 1 << " Wins uncontested!\n=========================================\n";
+        }
+    }
+
+    // ----------------------------  Private  ----------------------------
+    void Console::DrawTable(const Game& game) {
+        for (std::size_t i = 0; i < game.Players(); i++) {
+            if (game.InRound(i)) {
+                if (i == humanSeat) {
+                    std::cout << "Player " << i + 1 << "\nCash: " << game.Cash(i) << "\n" << game.Hole(i) << "\n";
+                }
+                else {
+                    std::cout << "Player " << i + 1 << "\nCash: " << game.Cash(i) << "\n" << "Cards:\n    \t#############\n\t#############\n" << "\n";
+                }
+            }
+        }
+        std::cout << "Community " << game.Board() << "\n";
+    }
+
+    char Console::GetInput(std::string prompt, std::vector<char> validInputs) {
+        char c;
+        std::cout << prompt;
+        do {
+            c = _getch();
+        } while (std::find(std::begin(validInputs), std::end(validInputs), std::toupper(c)) == std::end(validInputs));
+        std::cout << c << "\n";
+        return std::toupper(c);
+    }
+
+    // ---------------------------- Operators ----------------------------
+}
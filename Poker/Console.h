@@ -0,0 +1,33 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "Game.h"
+
+#include <string>
+#include <vector>
+
+namespace Poker {
+    // Terminal front end, plays one seat from the keyboard and prints the table as the game goes
+    class Console : public Game::Strategy, public Game::Listener {
+    private:
+        std::size_t humanSeat;
+
+    public:
+        Console(std::size_t humanSeat);
+        void Start(Game& game);
+
+        Game::Action Act(const Game& game, std::size_t seat) override;
+        void OnStreet(const Game& game) override;
+        void OnTurn(const Game& game, std::size_t seat) override;
+        void OnAction(const Game& game, std::size_t seat, Game::Action action, int amount) override;
+        void OnRefund(const Game& game, std::size_t seat, int amount) override;
+        void OnShowdown(const Game& game) override;
+        void OnWin(const Game& game, std::size_t seat, int amount) override;
+
+    private:
+        void DrawTable(const Game& game);
+        char GetInput(std::string prompt, std::vector<char> validInputs);
+    };
+}
+
+#endif
@@ -1,35 +1,54 @@
 #include "Deck.h"
+#include "Instrument.h"
 
 #include <algorithm>
-#include <random>
 #include <chrono>
+#include <stdexcept>
 
 #include <iostream>
 
 namespace Poker {
     // ----------------------------   Public   ----------------------------
-    Deck::Deck() {
-        for (int suit = static_cast<int>(Card::Suit::CLUBS); suit <= static_cast<int>(Card::Suit::SPADES); suit++) {
-            for (int rank = static_cast<int>(Card::Rank::TWO); rank <= static_cast<int>(Card::Rank::ACE); rank++) {
-                cards.push_back(Card(static_cast<Card::Rank>(rank), static_cast<Card::Suit>(suit)));
-            }
+    Deck::Deck() : Deck(static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count())) {}
+
+    Deck::Deck(std::uint64_t seed) : Deck(Random(seed)) {}
+
+    Deck::Deck(Random rng) : Deck(rng, CardSet::FullDeck()) {}
+
+    Deck::Deck(Random rng, CardSet contents) : cards({}), size(0), dealt(0), discardPile(), rng(rng) {
+        for (auto card : contents) {
+            cards[size++] = card.Id();
         }
-        Shuffle();
+    }
+
+    void Deck::Seed(std::uint64_t seed) {
+        rng.Seed(seed);
+    }
+
+    void Deck::Reset() {
+        // Draw() shuffles lazily, so rewinding the cursor is all a reshuffle needs
+        dealt = 0;
+        discardPile = {};
     }
 
     void Deck::Shuffle() {
-        std::shuffle(std::begin(cards), std::end(cards), std::default_random_engine(static_cast<long unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count())));
+        Instrument::Timer timer(Instrument::Counter::DECK_SHUFFLES, Instrument::Counter::DECK_SHUFFLE_NANOSECONDS);
+        for (std::size_t i = size; i > dealt + 1; i--) {
+            std::swap(cards[i - 1], cards[dealt + rng.Bounded(static_cast<std::uint32_t>(i - dealt))]);
+        }
     }
 
     Card Deck::Draw() {
-        if (cards.size() == 0) {
-            cards = discardPile;
-            Shuffle();
-            discardPile = {};
+        Instrument::Timer timer(Instrument::Counter::DECK_DRAWS, Instrument::Counter::DECK_DRAW_NANOSECONDS);
+        if (dealt == size) {
+            Refill();
+            if (dealt == size) {
+                throw std::out_of_range("Every card has been dealt and none discarded");
+            }
         }
-        Card card = cards.back();
-        cards.pop_back();
-        return card;
+        // One Fisher-Yates step, so the deck never needs a full shuffle before dealing
+        std::swap(cards[dealt], cards[dealt + rng.Bounded(static_cast<std::uint32_t>(size - dealt))]);
+        return Card::FromId(cards[dealt++]);
     }
 
     std::vector<Card> Deck::Draw(int n) {
@@ -41,15 +60,54 @@ namespace Poker {
     }
 
     void Deck::Discard(Card card) {
-        discardPile.push_back(card);
+        discardPile.Add(card);
+    }
+
+    void Deck::Discard(CardSet discards) {
+        discardPile |= discards;
     }
 
-    void Deck::Discard(std::vector<Card> discards) {
-        for (auto& card : discards) {
-            discardPile.push_back(card);
+    void Deck::Discard(const std::vector<Card>& discards) {
+        discardPile |= CardSet(discards);
+    }
+
+    void Deck::Remove(CardSet dead) {
+        // Keep the dealt and remaining regions apart while squeezing dead cards out of both
+        std::size_t kept = 0;
+        std::size_t keptDealt = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            if (i == dealt) {
+                keptDealt = kept;
+            }
+            if (!dead.Contains(Card::FromId(cards[i]))) {
+                cards[kept++] = cards[i];
+            }
         }
+        dealt = dealt == size ? kept : keptDealt;
+        size = kept;
+        discardPile -= dead;
+    }
+
+    CardSet Deck::Remaining() const {
+        CardSet remaining = {};
+        for (std::size_t i = dealt; i < size; i++) {
+            remaining |= CardSet::FromId(cards[i]);
+        }
+        return remaining;
     }
 
     // ----------------------------  Private  ----------------------------
+    void Deck::Refill() {
+        // Move discarded cards from the dealt region back behind the cursor
+        std::size_t stillDealt = 0;
+        for (std::size_t i = 0; i < dealt; i++) {
+            if (!discardPile.Contains(Card::FromId(cards[i]))) {
+                std::swap(cards[stillDealt++], cards[i]);
+            }
+        }
+        dealt = stillDealt;
+        discardPile = {};
+    }
+
     // ---------------------------- Operators ----------------------------
 }
\ No newline at end of file
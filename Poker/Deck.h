@@ -1,24 +1,43 @@
 #ifndef DECK_H
 #define DECK_H
 
+#include <array>
 #include <vector>
 
 #include "Card.h"
+#include "CardSet.h"
+#include "Random.h"
 
 namespace Poker {
+    // Fixed 52 slot deck, slots [0, dealt) have been dealt and [dealt, size) can still be drawn
+    // Discards are only tracked for reuse once the deck runs out, simulations can skip them and Reset() instead
     class Deck {
     private:
-        std::vector<Card> cards;
-        std::vector<Card> discardPile;
+        std::array<std::uint8_t, Card::DECK_SIZE> cards;    // Card ids
+        std::size_t size;
+        std::size_t dealt;
+        CardSet discardPile;
+        Random rng;
 
     public:
-        Deck();
-        void Shuffle();
-        Card Draw();
+        Deck();                     // Seeded from the clock
+        Deck(std::uint64_t seed);
+        Deck(Random rng);
+        Deck(Random rng, CardSet contents);     // A variant's deck, e.g. ShortDeck::DECK
+        void Seed(std::uint64_t seed);
+        void Reset();               // Return every dealt and discarded card to the deck
+        void Shuffle();             // Randomise the order of every remaining card
+        Card Draw();                // Uniformly random remaining card, only the dealt position is shuffled, throws std::out_of_range if none is left
         std::vector<Card> Draw(int n);
         void Discard(Card card);
-        void Discard(std::vector<Card> discards);
+        void Discard(CardSet discards);
+        void Discard(const std::vector<Card>& discards);
+        void Remove(CardSet dead);  // Take cards out of the deck for good
+        CardSet Remaining() const;
+
+    private:
+        void Refill();
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,242 @@
+#include "Equity.h"
+#include "Evaluator.h"
+#include "Parallel.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Poker {
+    // ----------------------------   Public   ----------------------------
+    template<typename Variant>
+    BasicEquity<Variant>::BasicEquity(std::vector<CardSet> holeCards, CardSet board, CardSet dead) : holeCards(holeCards), board(board), remaining({}) {
+        if (holeCards.size() < 2 || holeCards.size() > MAX_PLAYERS) {
+            throw std::invalid_argument("Equity needs between two and " + std::to_string(MAX_PLAYERS) + " players");
+        }
+        if (board.Size() > static_cast<int>(BOARD_SIZE)) {
+            throw std::invalid_argument("Board has more than " + std::to_string(BOARD_SIZE) + " cards");
+        }
+
+        CardSet used = board | dead;
+        int usedCount = board.Size() + dead.Size();
+        for (auto& hole : holeCards) {
+            if (hole.Size() != static_cast<int>(Variant::HOLE_CARDS)) {
+                throw std::invalid_argument("Each player needs " + std::to_string(Variant::HOLE_CARDS) + " hole cards");
+            }
+            used |= hole;
+            usedCount += hole.Size();
+        }
+        if (used.Size() != usedCount) {
+            throw std::invalid_argument("The same card is dealt more than once");
+        }
+        if (!(used - Variant::DECK).Empty()) {
+            throw std::invalid_argument("A card is not in this variant's deck");
+        }
+
+        for (auto card : Variant::DECK - used) {
+            remaining.push_back(card.Id());
+        }
+        if (remaining.size() < BOARD_SIZE - board.Size()) {
+            throw std::invalid_argument("Not enough cards left to complete the board");
+        }
+    }
+
+    template<typename Variant>
+    typename BasicEquity<Variant>::Result BasicEquity<Variant>::Simulate(std::uint64_t trials, std::uint64_t seed, unsigned threads) const {
+        const std::uint64_t chunks = (trials + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        const std::size_t needed = BOARD_SIZE - board.Size();
+
+        std::atomic<std::uint64_t> nextChunk = 0;
+        std::vector<Tally> tallies(Parallel::ThreadCount(threads), Tally(holeCards.size()));
+        auto work = [&](Tally& tally) {
+            std::vector<std::uint8_t> deck = {};
+            for (std::uint64_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++) {
+                // Each chunk starts from the same deck with its own stream, so the result doesn't depend on which thread ran it
+                deck = remaining;
+                Random rng(seed, chunk);
+                std::uint64_t chunkTrials = std::min(CHUNK_SIZE, trials - chunk * CHUNK_SIZE);
+                for (std::uint64_t trial = 0; trial < chunkTrials; trial++) {
+                    // Partial Fisher-Yates, only the cards dealt to the board are randomised
+                    CardSet fullBoard = board;
+                    for (std::size_t i = 0; i < needed; i++) {
+                        std::size_t j = i + rng.Bounded(static_cast<std::uint32_t>(deck.size() - i));
+                        std::swap(deck[i], deck[j]);
+                        fullBoard |= CardSet::FromId(deck[i]);
+                    }
+                    Showdown(fullBoard, tally);
+                }
+            }
+        };
+
+        Parallel::Fork(tallies.size(), [&](std::size_t i) { work(tallies[i]); });
+
+        for (std::size_t i = 1; i < tallies.size(); i++) {
+            tallies[0].Add(tallies[i]);
+        }
+        return Summarise(tallies[0], trials);
+    }
+
+    template<typename Variant>
+    typename BasicEquity<Variant>::Result BasicEquity<Variant>::Enumerate(unsigned threads) const {
+        const std::size_t needed = BOARD_SIZE - board.Size();
+
+        std::vector<Tally> tallies(Parallel::ThreadCount(threads), Tally(holeCards.size()));
+        if (needed == 0) {
+            Showdown(board, tallies[0]);
+            return Summarise(tallies[0], 1);
+        }
+
+        // Hold'em folds the hole cards and the known board into each player's state once, not once per leaf,
+        // other variants can't build a hand incrementally and score whole boards at the leaves
+        Evaluator::State states[MAX_PLAYERS];
+        if constexpr (std::is_same_v<Variant, Holdem>) {
+            for (std::size_t i = 0; i < holeCards.size(); i++) {
+                states[i] = Evaluator::State(holeCards[i] | board);
+            }
+        }
+
+        std::atomic<std::size_t> nextBranch = 0;
+        auto work = [&](Tally& tally) {
+            Evaluator::State branch[MAX_PLAYERS];
+            for (std::size_t first = nextBranch++; first + needed <= remaining.size(); first = nextBranch++) {
+                if constexpr (std::is_same_v<Variant, Holdem>) {
+                    for (std::size_t i = 0; i < holeCards.size(); i++) {
+                        branch[i] = states[i];
+                        branch[i].Add(Card::FromId(remaining[first]));
+                    }
+                    EnumerateBoards(first + 1, needed - 1, branch, tally);
+                }
+                else {
+                    EnumerateBoards(first + 1, needed - 1, board | CardSet::FromId(remaining[first]), tally);
+                }
+            }
+        };
+
+        Parallel::Fork(tallies.size(), [&](std::size_t i) { work(tallies[i]); });
+
+        for (std::size_t i = 1; i < tallies.size(); i++) {
+            tallies[0].Add(tallies[i]);
+        }
+        std::uint64_t boards = 1;
+        for (std::size_t i = 0; i < needed; i++) {
+            boards = boards * (remaining.size() - i) / (i + 1);
+        }
+        return Summarise(tallies[0], boards);
+    }
+
+    // ----------------------------  Private  ----------------------------
+    template<typename Variant>
+    BasicEquity<Variant>::Tally::Tally(std::size_t players) : wins(players, 0), ties(players * (players + 1), 0) {}
+
+    template<typename Variant>
+    void BasicEquity<Variant>::Tally::Add(const Tally& other) {
+        for (std::size_t i = 0; i < wins.size(); i++) {
+            wins[i] += other.wins[i];
+        }
+        for (std::size_t i = 0; i < ties.size(); i++) {
+            ties[i] += other.ties[i];
+        }
+    }
+
+    template<typename Variant>
+    void BasicEquity<Variant>::EnumerateBoards(std::size_t next, std::size_t needed, CardSet partialBoard, Tally& tally) const {
+        if (needed == 0) {
+            Showdown(partialBoard, tally);
+            return;
+        }
+        for (std::size_t i = next; i + needed <= remaining.size(); i++) {
+            EnumerateBoards(i + 1, needed - 1, partialBoard | CardSet::FromId(remaining[i]), tally);
+        }
+    }
+
+    template<typename Variant>
+    void BasicEquity<Variant>::EnumerateBoards(std::size_t next, std::size_t needed, const Evaluator::State* states, Tally& tally) const {
+        const std::size_t players = holeCards.size();
+        Evaluator::State extended[MAX_PLAYERS];
+        std::uint32_t strengths[MAX_PLAYERS];
+        if (needed == 0) {
+            for (std::size_t player = 0; player < players; player++) {
+                strengths[player] = states[player].Strength();
+            }
+            Showdown(strengths, tally);
+            return;
+        }
+
+        // The last card is scored in the same loop rather than one call deeper
+        for (std::size_t i = next; i + needed <= remaining.size(); i++) {
+            const Card card = Card::FromId(remaining[i]);
+            for (std::size_t player = 0; player < players; player++) {
+                extended[player] = states[player];
+                extended[player].Add(card);
+                strengths[player] = needed == 1 ? extended[player].Strength() : 0;
+            }
+            if (needed == 1) {
+                Showdown(strengths, tally);
+            }
+            else {
+                EnumerateBoards(i + 1, needed - 1, extended, tally);
+            }
+        }
+    }
+
+    template<typename Variant>
+    void BasicEquity<Variant>::Showdown(CardSet fullBoard, Tally& tally) const {
+        std::uint32_t strengths[MAX_PLAYERS];
+        for (std::size_t i = 0; i < holeCards.size(); i++) {
+            strengths[i] = Variant::Evaluate(holeCards[i], fullBoard);
+        }
+        Showdown(strengths, tally);
+    }
+
+    template<typename Variant>
+    void BasicEquity<Variant>::Showdown(const std::uint32_t* strengths, Tally& tally) const {
+        std::uint32_t best = 0;
+        std::size_t sharers = 0;
+        for (std::size_t i = 0; i < holeCards.size(); i++) {
+            if (strengths[i] > best) {
+                best = strengths[i];
+                sharers = 1;
+            }
+            else if (strengths[i] == best) {
+                sharers++;
+            }
+        }
+
+        for (std::size_t i = 0; i < holeCards.size(); i++) {
+            if (strengths[i] == best) {
+                if (sharers == 1) {
+                    tally.wins[i]++;
+                }
+                else {
+                    tally.ties[i * (holeCards.size() + 1) + sharers]++;
+                }
+            }
+        }
+    }
+
+    template<typename Variant>
+    typename BasicEquity<Variant>::Result BasicEquity<Variant>::Summarise(const Tally& tally, std::uint64_t trials) const {
+        const std::size_t players = holeCards.size();
+
+        Result result = { trials, tally.wins, std::vector<std::uint64_t>(players, 0), std::vector<std::uint64_t>(players, 0), std::vector<double>(players, 0.0) };
+        for (std::size_t i = 0; i < players; i++) {
+            double share = static_cast<double>(tally.wins[i]);
+            for (std::size_t sharers = 2; sharers <= players; sharers++) {
+                std::uint64_t ties = tally.ties[i * (players + 1) + sharers];
+                result.ties[i] += ties;
+                share += static_cast<double>(ties) / sharers;
+            }
+            result.losses[i] = trials - result.wins[i] - result.ties[i];
+            result.equity[i] = trials ? share / trials : 0.0;
+        }
+        return result;
+    }
+
+    template class BasicEquity<Holdem>;
+    template class BasicEquity<Omaha>;
+    template class BasicEquity<ShortDeck>;
+    template class BasicEquity<FiveCardDraw>;
+}
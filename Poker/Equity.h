@@ -0,0 +1,70 @@
+#ifndef EQUITY_H
+#define EQUITY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "CardSet.h"
+#include "Evaluator.h"
+#include "Variants.h"
+
+namespace Poker {
+    // All-in equity of known hole cards, over the boards that complete a (possibly partial) board
+    // Instantiated for each variant in Variants.h, Equity is the Hold'em one
+    template<typename Variant>
+    class BasicEquity {
+    public:
+        struct Result {
+            std::uint64_t trials;
+            std::vector<std::uint64_t> wins;    // Boards won outright, per player
+            std::vector<std::uint64_t> ties;    // Boards split with at least one other player
+            std::vector<std::uint64_t> losses;  // Boards lost
+            std::vector<double> equity;         // Share of the pot won on average, split pots shared evenly
+        };
+
+        static const std::size_t BOARD_SIZE = Variant::BOARD_CARDS;
+        static const std::size_t MAX_PLAYERS = Variant::DECK.Size() / Variant::HOLE_CARDS;
+
+        // Every player holds Variant::HOLE_CARDS cards from Variant::DECK
+        BasicEquity(std::vector<CardSet> holeCards, CardSet board = {}, CardSet dead = {});
+
+        // Monte Carlo estimate over random board completions
+        // Results depend only on trials and seed, not on the number of threads (0 for all cores)
+        Result Simulate(std::uint64_t trials, std::uint64_t seed, unsigned threads = 0) const;
+
+        // Exact equity over every board completion, branches on the first added card are split across threads
+        Result Enumerate(unsigned threads = 0) const;
+
+    private:
+        static const std::uint64_t CHUNK_SIZE = 1 << 14; // Trials per independently seeded RNG stream
+
+        // Per player wins plus ties bucketed by number of players sharing the pot, so merging stays exact
+        struct Tally {
+            std::vector<std::uint64_t> wins;
+            std::vector<std::uint64_t> ties;    // [player * (players + 1) + sharers]
+
+            Tally(std::size_t players);
+            void Add(const Tally& other);
+        };
+
+        std::vector<CardSet> holeCards;
+        CardSet board;
+        std::vector<std::uint8_t> remaining;    // Ids of cards that can still come on the board
+
+        void EnumerateBoards(std::size_t next, std::size_t needed, CardSet partialBoard, Tally& tally) const;
+        // Hold'em only, each player's state already holds the board so far and one card is added per level
+        void EnumerateBoards(std::size_t next, std::size_t needed, const Evaluator::State* states, Tally& tally) const;
+        void Showdown(CardSet fullBoard, Tally& tally) const;
+        void Showdown(const std::uint32_t* strengths, Tally& tally) const;
+        Result Summarise(const Tally& tally, std::uint64_t trials) const;
+    };
+
+    extern template class BasicEquity<Holdem>;
+    extern template class BasicEquity<Omaha>;
+    extern template class BasicEquity<ShortDeck>;
+    extern template class BasicEquity<FiveCardDraw>;
+
+    using Equity = BasicEquity<Holdem>;
+}
+
+#endif
@@ -0,0 +1,150 @@
+#include "EquityCache.h"
+#include "Instrument.h"
+#include "Isomorphism.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Poker {
+    namespace {
+        enum class Kind : std::uint64_t
+        {
+            ENUMERATE,
+            SIMULATE
+        };
+
+        std::vector<CardSet> Situation(const std::vector<CardSet>& holeCards, CardSet board, CardSet dead) {
+            std::vector<CardSet> sets = holeCards;
+            sets.push_back(board);
+            sets.push_back(dead);
+            // Canonicalizing works suit by suit and would drop bits past the deck, Equity has to see them to reject them
+            for (CardSet set : sets) {
+                if (!(set - CardSet::FullDeck()).Empty()) {
+                    throw std::invalid_argument("A card is not in this variant's deck");
+                }
+            }
+            return SuitIsomorphism::CanonicalizeAll(sets);
+        }
+    }
+
+    // ----------------------------   Public   ----------------------------
+    EquityCache::EquityCache(std::size_t capacity, std::size_t shardCount) : shards(std::clamp<std::size_t>(shardCount, 1, std::max<std::size_t>(capacity, 1))) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Equity cache needs room for at least one result");
+        }
+        // The remainder goes one each to the first shards, so the total is exactly capacity
+        for (std::size_t i = 0; i < shards.size(); i++) {
+            shards[i].capacity = capacity / shards.size() + (i < capacity % shards.size());
+        }
+    }
+
+    EquityCache::Result EquityCache::Enumerate(const std::vector<CardSet>& holeCards, CardSet board, CardSet dead, unsigned threads) {
+        std::vector<CardSet> canonical = Situation(holeCards, board, dead);
+        return Find(MakeKey(static_cast<std::uint64_t>(Kind::ENUMERATE), 0, 0, canonical), [&] {
+            std::vector<CardSet> holes(std::begin(canonical), std::end(canonical) - 2);
+            return Equity(holes, canonical[holes.size()], canonical[holes.size() + 1]).Enumerate(threads);
+        });
+    }
+
+    EquityCache::Result EquityCache::Simulate(const std::vector<CardSet>& holeCards, CardSet board, CardSet dead, std::uint64_t trials, std::uint64_t seed, unsigned threads) {
+        std::vector<CardSet> canonical = Situation(holeCards, board, dead);
+        return Find(MakeKey(static_cast<std::uint64_t>(Kind::SIMULATE), trials, seed, canonical), [&] {
+            std::vector<CardSet> holes(std::begin(canonical), std::end(canonical) - 2);
+            return Equity(holes, canonical[holes.size()], canonical[holes.size() + 1]).Simulate(trials, seed, threads);
+        });
+    }
+
+    std::size_t EquityCache::Size() const {
+        std::size_t size = 0;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            size += shard.index.size();
+        }
+        return size;
+    }
+
+    std::uint64_t EquityCache::Hits() const {
+        std::uint64_t hits = 0;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            hits += shard.hits;
+        }
+        return hits;
+    }
+
+    std::uint64_t EquityCache::Misses() const {
+        std::uint64_t misses = 0;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            misses += shard.misses;
+        }
+        return misses;
+    }
+
+    void EquityCache::Clear() {
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.index.clear();
+            shard.recent.clear();
+        }
+    }
+
+    // ----------------------------  Private  ----------------------------
+    std::size_t EquityCache::KeyHash::operator()(const Key& key) const {
+        return static_cast<std::size_t>(Hash(key));
+    }
+
+    std::uint64_t EquityCache::Hash(const Key& key) {
+        // SplitMix64 finaliser folded over the words
+        std::uint64_t hash = 0x9E3779B97F4A7C15;
+        for (auto word : key) {
+            hash ^= word;
+            hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+            hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+            hash ^= hash >> 31;
+        }
+        return hash;
+    }
+
+    EquityCache::Key EquityCache::MakeKey(std::uint64_t kind, std::uint64_t trials, std::uint64_t seed, const std::vector<CardSet>& canonical) {
+        Key key = { kind, trials, seed, canonical.size() };
+        for (auto set : canonical) {
+            key.push_back(set.mask);
+        }
+        return key;
+    }
+
+    template<typename Compute>
+    EquityCache::Result EquityCache::Find(const Key& key, Compute compute) {
+        // Low bits pick the bucket inside the shard's map, so the shard comes from the high ones
+        Shard& shard = shards[(Hash(key) >> 40) % shards.size()];
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto found = shard.index.find(key);
+            if (found != shard.index.end()) {
+                shard.hits++;
+                Instrument::Add(Instrument::Counter::EQUITY_CACHE_HITS);
+                shard.recent.splice(shard.recent.begin(), shard.recent, found->second);
+                return found->second->second;
+            }
+            shard.misses++;
+            Instrument::Add(Instrument::Counter::EQUITY_CACHE_MISSES);
+        }
+
+        // Computed unlocked, other situations in the shard stay available meanwhile
+        Result result = std::make_shared<const Equity::Result>(compute());
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            return found->second->second;   // Another thread got there first
+        }
+        if (shard.index.size() == shard.capacity) {
+            shard.index.erase(shard.recent.back().first);
+            shard.recent.pop_back();
+        }
+        shard.recent.emplace_front(key, result);
+        shard.index.emplace(key, shard.recent.begin());
+        return result;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef EQUITY_CACHE_H
+#define EQUITY_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "CardSet.h"
+#include "Equity.h"
+
+namespace Poker {
+    // Bounded cache of Equity results shared between threads, keyed by the canonical (suit relabelled) situation
+    // so every suit variant of a spot shares one entry. Results are always computed on the canonical situation,
+    // so a query returns the same numbers whether or not it hit
+    // Split into independently locked shards, each evicting its least recently used entry when full
+    class EquityCache {
+    public:
+        using Result = std::shared_ptr<const Equity::Result>;  // Shared so hits don't copy
+
+        // Capacity in results across all shards, never exceeded. There are no more shards than results it can hold
+        explicit EquityCache(std::size_t capacity, std::size_t shardCount = 64);
+
+        // As Equity, throwing the same std::invalid_argument for bad situations
+        // Concurrent misses on the same situation may both compute it, the cache keeps one
+        Result Enumerate(const std::vector<CardSet>& holeCards, CardSet board = {}, CardSet dead = {}, unsigned threads = 0);
+        Result Simulate(const std::vector<CardSet>& holeCards, CardSet board, CardSet dead, std::uint64_t trials, std::uint64_t seed, unsigned threads = 0);
+
+        std::size_t Size() const;
+        std::uint64_t Hits() const;
+        std::uint64_t Misses() const;
+        void Clear();
+
+    private:
+        // Query kind, trials, seed and player count, then the canonical hole cards, board and dead cards
+        using Key = std::vector<std::uint64_t>;
+        struct KeyHash {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::list<std::pair<Key, Result>> recent;  // Most recently used first
+            std::unordered_map<Key, std::list<std::pair<Key, Result>>::iterator, KeyHash> index;
+            std::size_t capacity = 0;           // Shard capacities add up to the cache's
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+        };
+
+        std::vector<Shard> shards;
+
+        static std::uint64_t Hash(const Key& key);
+        static Key MakeKey(std::uint64_t kind, std::uint64_t trials, std::uint64_t seed, const std::vector<CardSet>& canonical);
+        template<typename Compute>
+        Result Find(const Key& key, Compute compute);
+    };
+}
+
+#endif
@@ -0,0 +1,180 @@
+#include "Evaluator.h"
+#include "EvaluatorTables.h"
+#include "Hand.h"
+#include "Instrument.h"
+
+#include <algorithm>
+#include <cassert>
+#include <bit>
+
+// Every Evaluate and State::Strength share one scoring body, which has to stay inlined into each to keep Evaluate at its old speed
+#if defined(_MSC_VER)
+#define EVALUATOR_INLINE __forceinline
+#else
+#define EVALUATOR_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace Poker {
+    namespace {
+        using EvaluatorTables::TOP_CARD;
+        using EvaluatorTables::TOP_FIVE;
+
+        // Tables and type slots that differ between rules
+        template<typename Rules>
+        struct RuleTables {
+            static constexpr const auto& STRAIGHTS = EvaluatorTables::STRAIGHTS;
+            static constexpr const auto& FLUSHES = EvaluatorTables::FLUSHES;
+        };
+
+        template<>
+        struct RuleTables<Evaluator::ShortDeckRules> {
+            static constexpr const auto& STRAIGHTS = EvaluatorTables::SHORT_DECK_STRAIGHTS;
+            static constexpr const auto& FLUSHES = EvaluatorTables::SHORT_DECK_FLUSHES;
+        };
+
+        template<typename Rules>
+        constexpr std::uint32_t TypeBits(Hand::Type type) {
+            if constexpr (Rules::FLUSH_BEATS_FULL_HOUSE) {
+                type = type == Hand::Type::FLUSH ? Hand::Type::FULL_HOUSE : type == Hand::Type::FULL_HOUSE ? Hand::Type::FLUSH : type;
+            }
+            return EvaluatorTables::TypeBits(type);
+        }
+
+        std::uint32_t RankBit(std::uint32_t rank) {
+            return 1 << (rank - static_cast<int>(Card::Rank::TWO));
+        }
+    }
+
+    // ----------------------------   Public   ----------------------------
+    std::uint32_t Evaluator::Evaluate(CardSet cards) {
+        std::uint32_t strength = EvaluateCards<StandardRules>(cards);
+        Instrument::Evaluated(TypeOf<StandardRules>(strength));
+        return strength;
+    }
+
+    template<typename Rules>
+    std::uint32_t Evaluator::Evaluate(CardSet cards) {
+        std::uint32_t strength = EvaluateCards<Rules>(cards);
+        Instrument::Evaluated(TypeOf<Rules>(strength));
+        return strength;
+    }
+
+    Evaluator::State::State() : suits(0), counts(0) {}
+
+    Evaluator::State::State(CardSet cards) : State() {
+        for (auto card : cards) {
+            Add(card);
+        }
+    }
+
+    void Evaluator::State::Add(Card card) {
+        const std::uint64_t bit = RankBit(static_cast<std::uint32_t>(card.rank));
+        assert(!(suits & bit << (16 * static_cast<int>(card.suit))));
+
+        // The rank moves up one multiplicity level, every level it already reached copies into the one above
+        suits |= bit << (16 * static_cast<int>(card.suit));
+        counts |= bit | (counts & bit * 0x0000000100010001) << 16;
+    }
+
+    std::uint32_t Evaluator::State::Strength() const {
+        const std::uint32_t MASK = 0xFFFF;
+        std::uint32_t strength = Score<StandardRules>(suits & MASK, suits >> 16 & MASK, suits >> 32 & MASK, suits >> 48,
+            counts & MASK, counts >> 48, counts >> 32 & MASK, counts >> 16 & MASK);
+        Instrument::Evaluated(TypeOf<StandardRules>(strength));
+        return strength;
+    }
+
+    Hand::Type Evaluator::State::Type() const {
+        return static_cast<Hand::Type>(Strength() >> TYPE_SHIFT);
+    }
+
+    std::size_t Evaluator::State::Size() const {
+        return std::popcount(suits);
+    }
+
+    CardSet Evaluator::State::Cards() const {
+        std::uint64_t mask = 0;
+        for (int suit = 0; suit < Card::SUIT_COUNT; suit++) {
+            mask |= (suits >> (16 * suit) & 0xFFFF) << (suit * Card::RANK_COUNT);
+        }
+        return CardSet(mask);
+    }
+
+    // ----------------------------  Private  ----------------------------
+    template<typename Rules>
+    EVALUATOR_INLINE std::uint32_t Evaluator::EvaluateCards(CardSet cards) {
+        const std::uint32_t clubs = cards.Suit(Card::Suit::CLUBS);
+        const std::uint32_t diamonds = cards.Suit(Card::Suit::DIAMONDS);
+        const std::uint32_t hearts = cards.Suit(Card::Suit::HEARTS);
+        const std::uint32_t spades = cards.Suit(Card::Suit::SPADES);
+
+        const std::uint32_t ranks = clubs | diamonds | hearts | spades;
+        const std::uint32_t quads = clubs & diamonds & hearts & spades;
+        const std::uint32_t tripsPlus = (clubs & diamonds & hearts) | (clubs & diamonds & spades) | (clubs & hearts & spades) | (diamonds & hearts & spades);
+        const std::uint32_t pairsPlus = (clubs & diamonds) | (clubs & hearts) | (clubs & spades) | (diamonds & hearts) | (diamonds & spades) | (hearts & spades);
+
+        return Score<Rules>(clubs, diamonds, hearts, spades, ranks, quads, tripsPlus, pairsPlus);
+    }
+
+    template<typename Rules>
+    EVALUATOR_INLINE std::uint32_t Evaluator::Score(std::uint32_t clubs, std::uint32_t diamonds, std::uint32_t hearts, std::uint32_t spades,
+        std::uint32_t ranks, std::uint32_t quads, std::uint32_t tripsPlus, std::uint32_t pairsPlus) {
+        const auto& STRAIGHTS = RuleTables<Rules>::STRAIGHTS;
+        const auto& FLUSHES = RuleTables<Rules>::FLUSHES;
+
+        // Flushes and straights need five distinct ranks
+        std::uint32_t flush = 0;
+        if (std::popcount(ranks) >= 5) {
+            flush = std::max(std::max(FLUSHES[clubs], FLUSHES[diamonds]), std::max(FLUSHES[hearts], FLUSHES[spades]));
+            if (flush >= TypeBits<Rules>(Hand::Type::STRAIGHT_FLUSH)) {
+                return flush;
+            }
+        }
+
+        if (quads) {
+            std::uint32_t quad = TOP_CARD[quads];
+            return TypeBits<Rules>(Hand::Type::FOUR_OF_A_KIND) | quad << 16 | TOP_CARD[ranks & ~RankBit(quad)] << 12;
+        }
+
+        if constexpr (Rules::FLUSH_BEATS_FULL_HOUSE) {
+            if (flush) {
+                return flush;
+            }
+        }
+
+        if (tripsPlus) {
+            std::uint32_t trip = TOP_CARD[tripsPlus];
+            std::uint32_t rest = pairsPlus & ~RankBit(trip);
+            if (rest) {
+                return TypeBits<Rules>(Hand::Type::FULL_HOUSE) | trip << 16 | TOP_CARD[rest] << 12;
+            }
+        }
+
+        if (flush) {
+            return flush;
+        }
+
+        if (STRAIGHTS[ranks]) {
+            return TypeBits<Rules>(Hand::Type::STRAIGHT) | STRAIGHTS[ranks] << 16;
+        }
+
+        if (tripsPlus) {
+            std::uint32_t trip = TOP_CARD[tripsPlus];
+            return TypeBits<Rules>(Hand::Type::THREE_OF_A_KIND) | trip << 16 | ((TOP_FIVE[ranks & ~RankBit(trip)] >> 4) & 0xFF00);
+        }
+
+        if (pairsPlus) {
+            std::uint32_t high = TOP_CARD[pairsPlus];
+            std::uint32_t low = TOP_CARD[pairsPlus & ~RankBit(high)];
+            if (low) {
+                return TypeBits<Rules>(Hand::Type::TWO_PAIR) | high << 16 | low << 12 | TOP_CARD[ranks & ~RankBit(high) & ~RankBit(low)] << 8;
+            }
+            return TypeBits<Rules>(Hand::Type::PAIR) | high << 16 | ((TOP_FIVE[ranks & ~RankBit(high)] >> 4) & 0xFFF0);
+        }
+
+        return TypeBits<Rules>(Hand::Type::HIGH_CARD) | TOP_FIVE[ranks];
+    }
+
+    template std::uint32_t Evaluator::Evaluate<Evaluator::StandardRules>(CardSet cards);
+    template std::uint32_t Evaluator::Evaluate<Evaluator::ShortDeckRules>(CardSet cards);
+}
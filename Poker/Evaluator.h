@@ -0,0 +1,67 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include <cstdint>
+
+#include "CardSet.h"
+#include "Hand.h"
+
+namespace Poker {
+    // Table driven hand evaluator, the tables are built at compile time in EvaluatorTables.h
+    // Strength layout: Hand::Type in bits 20-23, then up to five ranks in 4 bit slots (bits 16-19 down to bits 0-3)
+    // Strengths compare as plain integers, higher is better
+    class Evaluator {
+    public:
+        static const int TYPE_SHIFT = 20;
+
+        // Hand rankings, chosen at compile time
+        struct StandardRules {
+            static constexpr bool FLUSH_BEATS_FULL_HOUSE = false;
+        };
+        struct ShortDeckRules {                 // Sixes and up, A-6-7-8-9 is the lowest straight
+            static constexpr bool FLUSH_BEATS_FULL_HOUSE = true;
+        };
+
+        static std::uint32_t Evaluate(CardSet cards);       // StandardRules
+        template<typename Rules>
+        static std::uint32_t Evaluate(CardSet cards);       // Instantiated for the rules above
+
+        // Type slots follow the rules' ranking, so short deck swaps FLUSH and FULL_HOUSE in the strength
+        template<typename Rules>
+        static constexpr Hand::Type TypeOf(std::uint32_t strength) {
+            Hand::Type type = static_cast<Hand::Type>(strength >> TYPE_SHIFT);
+            if constexpr (Rules::FLUSH_BEATS_FULL_HOUSE) {
+                type = type == Hand::Type::FLUSH ? Hand::Type::FULL_HOUSE : type == Hand::Type::FULL_HOUSE ? Hand::Type::FLUSH : type;
+            }
+            return type;
+        }
+
+        // Cards seen so far under StandardRules, kept as the rank multiplicity masks Evaluate would otherwise rebuild from scratch
+        // Copy it before adding to branch, e.g. once per turn card from a flop state
+        class State {
+        public:
+            State();
+            explicit State(CardSet cards);
+            void Add(Card card);                // O(1), the card must not already be in the state
+            std::uint32_t Strength() const;     // Best hand of the cards so far, final once there are seven
+            Hand::Type Type() const;
+            std::size_t Size() const;
+            CardSet Cards() const;
+
+        private:
+            // Two words so copies stay in registers, each packs four 16 bit rank masks
+            std::uint64_t suits;        // One mask per suit
+            std::uint64_t counts;       // Ranks held at least once, twice, three and four times
+        };
+
+    private:
+        // Defined force-inline in Evaluator.cpp, declared inline here to match
+        template<typename Rules>
+        static inline std::uint32_t EvaluateCards(CardSet cards);
+        template<typename Rules>
+        static inline std::uint32_t Score(std::uint32_t clubs, std::uint32_t diamonds, std::uint32_t hearts, std::uint32_t spades,
+            std::uint32_t ranks, std::uint32_t quads, std::uint32_t tripsPlus, std::uint32_t pairsPlus);
+    };
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef EVALUATORTABLES_H
+#define EVALUATORTABLES_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "Card.h"
+#include "Evaluator.h"
+#include "Hand.h"
+
+// Lookup tables behind Evaluator, generated by the compiler and stored in the binary's read only data
+// Indexed by a 13 bit rank mask, bit 0 for TWO up to bit 12 for ACE
+// Only include this where the tables are read, building them adds a second or so to each translation unit
+namespace Poker {
+    namespace EvaluatorTables {
+        constexpr std::size_t TABLE_SIZE = 1 << Card::RANK_COUNT;
+
+        constexpr std::uint32_t TypeBits(Hand::Type type) {
+            return static_cast<std::uint32_t>(type) << Evaluator::TYPE_SHIFT;
+        }
+
+        // Rank of highest card in rank mask
+        consteval std::array<std::uint8_t, TABLE_SIZE> BuildTopCard() {
+            std::array<std::uint8_t, TABLE_SIZE> table = {};
+            for (std::size_t mask = 1; mask < TABLE_SIZE; mask++) {
+                table[mask] = static_cast<std::uint8_t>(std::bit_width(mask) - 1 + static_cast<int>(Card::Rank::TWO));
+            }
+            return table;
+        }
+
+        // Ranks of five highest cards in rank mask, packed into rank slots
+        consteval std::array<std::uint32_t, TABLE_SIZE> BuildTopFive() {
+            std::array<std::uint32_t, TABLE_SIZE> table = {};
+            for (std::size_t mask = 0; mask < TABLE_SIZE; mask++) {
+                std::uint32_t packed = 0;
+                int shift = 16;
+                for (int bit = Card::RANK_COUNT - 1; bit >= 0 && shift >= 0; bit--) {
+                    if (mask & (1 << bit)) {
+                        packed |= (bit + static_cast<std::uint32_t>(Card::Rank::TWO)) << shift;
+                        shift -= 4;
+                    }
+                }
+                table[mask] = packed;
+            }
+            return table;
+        }
+
+        // Rank of high card of best straight in rank mask, 0 if none
+        // lowStraight is the ace-low straight's mask, lowStraightHigh the rank it counts as
+        consteval std::array<std::uint8_t, TABLE_SIZE> BuildStraights(std::uint16_t lowStraight, Card::Rank lowStraightHigh) {
+            const std::uint16_t STRAIGHT = 0b0000000000011111;
+
+            std::array<std::uint8_t, TABLE_SIZE> table = {};
+            for (std::size_t mask = 0; mask < TABLE_SIZE; mask++) {
+                for (int rankOffset = 0; rankOffset < 9; rankOffset++) {
+                    std::size_t straight = STRAIGHT << (8 - rankOffset);
+                    if ((mask & straight) == straight) {
+                        table[mask] = static_cast<std::uint8_t>(static_cast<int>(Card::Rank::ACE) - rankOffset);
+                        break;
+                    }
+                }
+                if (!table[mask] && (mask & lowStraight) == lowStraight) {
+                    table[mask] = static_cast<std::uint8_t>(lowStraightHigh);
+                }
+            }
+            return table;
+        }
+
+        // Strength of flush/straight flush for suit mask, 0 if < 5 cards
+        // flushBits is the flush's type in the rules' ranking, already shifted into place
+        consteval std::array<std::uint32_t, TABLE_SIZE> BuildFlushes(const std::array<std::uint8_t, TABLE_SIZE>& straights, std::uint32_t flushBits) {
+            const auto topFive = BuildTopFive();
+
+            std::array<std::uint32_t, TABLE_SIZE> table = {};
+            for (std::size_t mask = 0; mask < TABLE_SIZE; mask++) {
+                if (std::popcount(mask) < 5) {
+                    continue;
+                }
+                if (straights[mask]) {
+                    table[mask] = TypeBits(Hand::Type::STRAIGHT_FLUSH) | straights[mask] << 16;
+                }
+                else {
+                    table[mask] = flushBits | topFive[mask];
+                }
+            }
+            return table;
+        }
+
+        // Byte tables widened for 32 bit gathers in the vector kernels
+        consteval std::array<std::uint32_t, TABLE_SIZE> Widen(const std::array<std::uint8_t, TABLE_SIZE>& narrow) {
+            std::array<std::uint32_t, TABLE_SIZE> table = {};
+            for (std::size_t mask = 0; mask < TABLE_SIZE; mask++) {
+                table[mask] = narrow[mask];
+            }
+            return table;
+        }
+
+        inline constexpr std::array<std::uint8_t, TABLE_SIZE> TOP_CARD = BuildTopCard();
+        inline constexpr std::array<std::uint32_t, TABLE_SIZE> TOP_FIVE = BuildTopFive();
+        inline constexpr std::array<std::uint8_t, TABLE_SIZE> STRAIGHTS = BuildStraights(0b1000000001111, Card::Rank::FIVE);
+        inline constexpr std::array<std::uint32_t, TABLE_SIZE> FLUSHES = BuildFlushes(STRAIGHTS, TypeBits(Hand::Type::FLUSH));
+
+        // Short deck, A-6-7-8-9 is the lowest straight and flushes rank above full houses (in FULL_HOUSE's slot)
+        inline constexpr std::array<std::uint8_t, TABLE_SIZE> SHORT_DECK_STRAIGHTS = BuildStraights(0b1000011110000, Card::Rank::NINE);
+        inline constexpr std::array<std::uint32_t, TABLE_SIZE> SHORT_DECK_FLUSHES = BuildFlushes(SHORT_DECK_STRAIGHTS, TypeBits(Hand::Type::FULL_HOUSE));
+        inline constexpr std::array<std::uint32_t, TABLE_SIZE> TOP_CARD_WIDE = Widen(TOP_CARD);
+        inline constexpr std::array<std::uint32_t, TABLE_SIZE> STRAIGHTS_WIDE = Widen(STRAIGHTS);
+
+        static_assert(TOP_CARD[0b1000000000000] == static_cast<std::uint8_t>(Card::Rank::ACE));
+        static_assert(STRAIGHTS[0b1000000001111] == static_cast<std::uint8_t>(Card::Rank::FIVE));
+        static_assert(STRAIGHTS[0b1111100000000] == static_cast<std::uint8_t>(Card::Rank::ACE));
+        static_assert(FLUSHES[0b1111100000000] == (TypeBits(Hand::Type::STRAIGHT_FLUSH) | 14 << 16));
+        static_assert(FLUSHES[0b0000000101111] == (TypeBits(Hand::Type::FLUSH) | 0x75432));
+        static_assert(SHORT_DECK_STRAIGHTS[0b1000011110000] == static_cast<std::uint8_t>(Card::Rank::NINE));
+        static_assert(SHORT_DECK_STRAIGHTS[0b1000000001111] == 0);
+    }
+}
+
+#endif
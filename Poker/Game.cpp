@@ -1,15 +1,24 @@
 #include "Game.h"
-#include "getch.h"
+#include "Evaluator.h"
+#include "Instrument.h"
+#include "ShowdownResolver.h"
 
-#include <iostream>
 #include <algorithm>
-#include <cstdio>
+#include <chrono>
+#include <stdexcept>
+#include <string>
 
 
 
 namespace Poker {
     // ----------------------------   Public   ----------------------------
-    Game::Game(int players) :deck(Deck()), buttonPos(0), pot(0), minimumBet(STARTING_CASH / 10), hands({}), communityCards({}), cash({}), bets({}), inRound({}) {
+    Game::Game(int players) : Game(players, static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count())) {}
+
+    Game::Game(int players, std::uint64_t seed) : seed(seed), handNumber(0), deck(Deck(seed)), buttonPos(0), pot(0), minimumBet(STARTING_CASH / 6), currentBet(0), street(Street::PRE_FLOP), live(0),
+        hands({}), communityCards({}), cash({}), bets({}), contributed({}), strengths({}), inRound({}), acted({}), strategies({}), listener(nullptr) {
+        if (players < 2 || players > MAX_PLAYERS) {
+            throw std::invalid_argument("A game needs between two and " + std::to_string(MAX_PLAYERS) + " players");
+        }
         for (int i = 0; i < players; i++) {
             hands.push_back({});
         }
@@ -19,169 +28,291 @@ namespace Poker {
         for (int i = 0; i < players; i++) {
             bets.push_back(0);
         }
+        for (int i = 0; i < players; i++) {
+            contributed.push_back(0);
+        }
+        for (int i = 0; i < players; i++) {
+            strengths.push_back(0);
+        }
         for (int i = 0; i < players; i++) {
             inRound.push_back(true);
         }
+        for (int i = 0; i < players; i++) {
+            acted.push_back(false);
+        }
+        for (int i = 0; i < players; i++) {
+            strategies.push_back(&DefaultStrategy());
+        }
     }
 
-    void Game::Start() {
-        buttonPos = 0;
-        minimumBet = STARTING_CASH / 6;
-        while (GetInput("Play Round? ([Y]es, [N]o): ", { 'Y', 'N' }) != 'N') {
-            // Play
-            PlayRound();
-
+    void Game::SetStrategy(std::size_t seat, Strategy& strategy) {
+        strategies[seat] = &strategy;
+    }
 
-            // Reset
-            pot = 0;
-            buttonPos = (buttonPos + 1) % hands.size();
-            for (int i = 0; i < hands.size(); i++) {
-                bets[i] = 0;
-                inRound[i] = true;
-            }
-            for (auto& hand : hands) {
-                hand.Discard(deck);
-            }
-            communityCards.Discard(deck);
+    void Game::SetListener(Listener* listener) {
+        this->listener = listener;
+    }
 
+    bool Game::PlayHand() {
+        Instrument::Add(Instrument::Counter::HANDS);
+        PlayRound();
+        EndHand();
+        return Winner() == -1;
+    }
 
-            // Check finished
-            int winner = -1;
-            for (int i = 0; i < hands.size(); i++) {
-                if (cash[i] > 0 && winner != -1) {
-                    winner = -1;
-                    break; // No winner yet
-                }
-                else if (cash[i] > 0) {
-                    winner = i;
-                }
+    int Game::Winner() const {
+        int winner = -1;
+        for (int i = 0; i < hands.size(); i++) {
+            if (cash[i] > 0 && winner != -1) {
+                return -1; // No winner yet
             }
-            if (winner != -1) {
-                std::cout << "Player " << winner + 1 << " won the game!";
-                break;
+            else if (cash[i] > 0) {
+                winner = i;
             }
         }
+        return winner;
+    }
+
+    std::uint64_t Game::Seed() const {
+        return seed;
+    }
+
+    std::uint64_t Game::HandNumber() const {
+        return handNumber;
+    }
+
+    std::size_t Game::Players() const {
+        return hands.size();
+    }
+
+    std::size_t Game::Button() const {
+        return buttonPos;
+    }
+
+    std::size_t Game::SmallBlind() const {
+        return (buttonPos + 1) % hands.size();
+    }
+
+    std::size_t Game::BigBlind() const {
+        return (buttonPos + 2) % hands.size();
+    }
+
+    Game::Street Game::CurrentStreet() const {
+        return street;
+    }
+
+    const Hand& Game::Hole(std::size_t seat) const {
+        return hands[seat];
+    }
+
+    const Hand& Game::Board() const {
+        return communityCards;
+    }
+
+    int Game::Cash(std::size_t seat) const {
+        return cash[seat];
+    }
+
+    int Game::Bet(std::size_t seat) const {
+        return bets[seat];
+    }
+
+    bool Game::InRound(std::size_t seat) const {
+        return inRound[seat];
+    }
+
+    int Game::CurrentBet() const {
+        return currentBet;
+    }
+
+    int Game::MinimumBet() const {
+        return minimumBet;
+    }
+
+    int Game::Pot() const {
+        return pot;
+    }
+
+    std::uint32_t Game::Strength(std::size_t seat) const {
+        return strengths[seat];
     }
 
     // ----------------------------  Private  ----------------------------
+    Game::Strategy& Game::DefaultStrategy() {
+        class CallEverything : public Strategy {
+        public:
+            Action Act(const Game&, std::size_t) override {
+                return Action::CALL;
+            }
+        };
+        static CallEverything strategy;
+        return strategy;
+    }
 
     void Game::PlayRound() {
         // Deal
+        street = Street::PRE_FLOP;
         PlayerDeal();
-        DrawTable();
-        BettingRound();
-
-        // Flop
-        TableDeal(3);
-        DrawTable();
-        BettingRound();
-
-        // Turn
-        TableDeal(1);
-        DrawTable();
-        BettingRound();
-
-        // River
-        TableDeal(1);
-        DrawTable();
+        if (listener) {
+            listener->OnStreet(*this);
+        }
         BettingRound();
 
-        // Showdown
-        for (int i = 0; i < hands.size(); i++) {
-            if (inRound[i]) {
-                std::cout << "Player " << i + 1 << " " << hands[i] << "\n";
+        // Flop, Turn, River
+        for (int cards : { 3, 1, 1 }) {
+            if (live <= 1) {
+                break;
             }
+            street = static_cast<Street>(static_cast<int>(street) + 1);
+            TableDeal(cards);
+            if (listener) {
+                listener->OnStreet(*this);
+            }
+            BettingRound();
         }
-        std::cout << "Community " << communityCards << "\n";
 
-        int winner = std::distance(std::begin(hands), std::max_element(
-            std::begin(hands),
-            std::end(hands),
-            [this](Hand& a, Hand& b) {
-                return (a + communityCards) < (b + communityCards);
-            }));
-        std::cout << "Player " << winner + 1 << " Wins with " << Hand::TYPE_NAMES[(hands[winner] + communityCards).Score().first]((hands[winner] + communityCards).Score().second) << "!\n=========================================\n";
-        cash[winner] += pot;
+        // Everyone else folded
+        if (live == 1) {
+            std::size_t winner = std::distance(std::begin(inRound), std::find(std::begin(inRound), std::end(inRound), true));
+            Award(winner, pot);
+            return;
+        }
+
+        street = Street::SHOWDOWN;
+        Showdown();
     }
 
     void Game::BettingRound() {
-        std::size_t smallBlindPos = (buttonPos + 1) % hands.size();
-        std::size_t bigBlindPos = (buttonPos + 2) % hands.size();
-        std::size_t currentBetter = (buttonPos + 3) % hands.size();
-
-        int currentBet = minimumBet;
-        bets[smallBlindPos] = minimumBet / 2 < cash[smallBlindPos] ? currentBet / 2 : cash[smallBlindPos];
-        cash[smallBlindPos] -= bets[smallBlindPos];
-        bets[bigBlindPos] = minimumBet / 2 < cash[bigBlindPos] ? currentBet : cash[bigBlindPos];
-        cash[bigBlindPos] -= bets[bigBlindPos];
-
-
-        while (true) {
-            // Check if finished
-            // TODO: Only continue after all players have called/checked (allowing big blind to raise on first round for example
-            // TODO: Only force bets on first round
-            // TODO: Fix infinite loop cause when there's 1 player?
+        std::size_t currentBetter = (buttonPos + 1) % hands.size();
+        currentBet = 0;
+        if (street == Street::PRE_FLOP) {
+            PostBlind(SmallBlind(), minimumBet / 2);
+            PostBlind(BigBlind(), minimumBet);
+            currentBet = minimumBet;
+            currentBetter = (buttonPos + 3) % hands.size();
+        }
+        std::fill(std::begin(acted), std::end(acted), false);
+
+        while (live > 1) {
+            Instrument::Add(Instrument::Counter::BETTING_ITERATIONS);
+            // Finished once everyone who can still bet has acted and matched the current bet
             bool done = true;
             for (std::size_t i = 0; i < hands.size(); i++) {
-                if (bets[i] == currentBet || cash[i] == 0 || !inRound[i]) {
-                    continue;
+                if (inRound[i] && cash[i] > 0 && (!acted[i] || bets[i] < currentBet)) {
+                    done = false;
+                    break;
                 }
-                done = false;
             }
             if (done) {
                 break;
             }
-            if (cash[currentBetter] == 0 || !inRound[currentBetter]) {
-                continue;
-            }
 
-            // Display current bets
-            std::cout << "Current bets:" << "\n";
-            for (std::size_t i = 0; i < hands.size(); i++) {
-                if (inRound[i]) {
-                    std::cout << "\t\b\b\b"
-                        << (i == smallBlindPos ? "b" : i == bigBlindPos ? "B" : " ")
-                        << (i == currentBetter ? ">" : " ")
-                        << " Player " << i + 1 << ": " << bets[i] << "\n";
+            if (inRound[currentBetter] && cash[currentBetter] > 0 && (!acted[currentBetter] || bets[currentBetter] < currentBet)) {
+                if (listener) {
+                    listener->OnTurn(*this, currentBetter);
+                }
+                Action action = strategies[currentBetter]->Act(*this, currentBetter);
+                int amount = Apply(currentBetter, action);
+                acted[currentBetter] = true;
+                if (listener) {
+                    listener->OnAction(*this, currentBetter, action, amount);
                 }
             }
+            currentBetter = (currentBetter + 1) % hands.size();
+        }
+        for (std::size_t i = 0; i < hands.size(); i++) {
+            pot += bets[i];
+            contributed[i] += bets[i];
+            bets[i] = 0;
+        }
+    }
 
-            // Act
-            char action = currentBetter == 0 ? GetInput("Enter an action ([F]old, [C]heck/[C]all, [R]aise): ", { 'F', 'C', 'R' }) : 'C';
+    int Game::Apply(std::size_t seat, Action action) {
+        switch (action) {
+        case Action::FOLD:
+            inRound[seat] = false;
+            live--;
+            return 0;
+        case Action::CALL:
+        {
+            int callAmount = std::min(currentBet - bets[seat], cash[seat]);
+            bets[seat] += callAmount;
+            cash[seat] -= callAmount;
+            return callAmount;
+        }
+        case Action::RAISE:
+        {
+            int raiseTo = std::min(currentBet + minimumBet, bets[seat] + cash[seat]);
+            int raiseAmount = raiseTo - bets[seat];
+            currentBet = std::max(currentBet, raiseTo);
+            bets[seat] += raiseAmount;
+            cash[seat] -= raiseAmount;
+            return raiseAmount;
+        }
+        }
+        return 0;
+    }
 
-            switch (action) {
-            case 'C':
-            {
-                int callAmount = std::min(currentBet - bets[currentBetter], cash[currentBetter]);
-                bets[currentBetter] += callAmount;
-                cash[currentBetter] -= callAmount;
-                std::cout << "Player " << currentBetter + 1 << " Called" << "\n\n";
-            }
-            break;
-            case 'F':
-                inRound[currentBetter] = false;
-                std::cout << "Player " << currentBetter + 1 << " Folder" << "\n\n";
-                break;
-            case 'R':
-            {
-                int raiseAmount = std::min(currentBet + minimumBet - bets[currentBetter], cash[currentBetter]);
-                currentBet += minimumBet;
-                bets[currentBetter] += raiseAmount;
-                cash[currentBetter] -= raiseAmount;
-                std::cout << "Player " << currentBetter + 1 << " Raised to " << raiseAmount << "\n\n";
+    void Game::PostBlind(std::size_t seat, int amount) {
+        if (!inRound[seat]) {
+            return;
+        }
+        bets[seat] = std::min(amount, cash[seat]);
+        cash[seat] -= bets[seat];
+    }
+
+    void Game::Showdown() {
+        Refund();
+        if (listener) {
+            listener->OnShowdown(*this);
+        }
+
+        // Each live hand is scored once, folded seats keep 0 and can't win
+        for (std::size_t i = 0; i < hands.size(); i++) {
+            if (inRound[i]) {
+                strengths[i] = Evaluator::Evaluate(hands[i].Cards() | communityCards.Cards());
             }
-            break;
+        }
+        std::vector<int> winnings = ShowdownResolver::Resolve(contributed, strengths, buttonPos);
+        for (std::size_t i = 0; i < hands.size(); i++) {
+            if (winnings[i] > 0) {
+                Award(i, winnings[i]);
             }
-            currentBetter = (currentBetter + 1) % hands.size();
-            GetInput("Press space to continue...", { ' ' });
         }
+    }
+
+    void Game::Refund() {
+        // Chips above what every other seat put in were never called, they aren't won by anyone
+        std::size_t top = std::distance(std::begin(contributed), std::max_element(std::begin(contributed), std::end(contributed)));
+        int matched = 0;
         for (std::size_t i = 0; i < hands.size(); i++) {
-            pot += bets[i];
-            bets[i] = 0;
+            if (i != top) {
+                matched = std::max(matched, contributed[i]);
+            }
+        }
+        int uncalled = contributed[top] - matched;
+        if (uncalled <= 0) {
+            return;
+        }
+        contributed[top] = matched;
+        cash[top] += uncalled;
+        pot -= uncalled;
+        if (listener) {
+            listener->OnRefund(*this, top, uncalled);
+        }
+    }
+
+    void Game::Award(std::size_t seat, int amount) {
+        cash[seat] += amount;
+        pot -= amount;
+        if (listener) {
+            listener->OnWin(*this, seat, amount);
         }
     }
 
     void Game::PlayerDeal() {
+        deck.Reset();
+        live = 0;
         for (int i = 0; i < 2; i++) {
             for (int player = buttonPos + 1; player < hands.size(); player++) {
                 if (cash[player] != 0) {
@@ -200,36 +331,33 @@ namespace Poker {
                 }
             }
         }
+        for (std::size_t player = 0; player < hands.size(); player++) {
+            live += inRound[player];
+        }
     }
 
     void Game::TableDeal(int n) {
-        deck.Discard(deck.Draw(1));
+        deck.Draw(); // Burn
         communityCards.Draw(deck, n);
     }
 
-    void Game::DrawTable() {
+    void Game::EndHand() {
+        if (listener) {
+            listener->OnHandEnd(*this);
+        }
+        pot = 0;
+        currentBet = 0;
+        buttonPos = (buttonPos + 1) % hands.size();
         for (int i = 0; i < hands.size(); i++) {
-            if (inRound[i]) {
-                if (i == 0) {
-                    std::cout << "Player " << i + 1 << "\nCash: " << cash[i] << "\n" << hands[i] << "\n";
-                }
-                else {
-                    std::cout << "Player " << i + 1 << "\nCash: " << cash[i] << "\n" << "Cards:\n    \t#############\n\t#############\n" << "\n";
-                }
-            }
+            bets[i] = 0;
+            contributed[i] = 0;
+            strengths[i] = 0;
+            inRound[i] = true;
+            hands[i].Clear();
         }
-        std::cout << "Community " << communityCards << "\n";
-    }
-
-    char Game::GetInput(std::string prompt, std::vector<char> validInputs) {
-        char c;
-        std::cout << prompt;
-        do {
-            c = _getch();
-        } while (std::find(std::begin(validInputs), std::end(validInputs), std::toupper(c)) == std::end(validInputs));
-        std::cout << c << "\n";
-        return std::toupper(c);
+        communityCards.Clear();
+        handNumber++;
     }
 
     // ---------------------------- Operators ----------------------------
-}
\ No newline at end of file
+}
@@ -5,33 +5,107 @@
 #include "Hand.h"
 
 namespace Poker {
+    // Hold'em table state machine, with no I/O of its own
+    // Seats decide through a Strategy, anything that wants to watch the game (a console, a log) is a Listener
     class Game {
-    private:
+    public:
+        enum class Action
+        {
+            FOLD,
+            CALL,   // Check when there's nothing to call
+            RAISE   // By minimumBet, capped at the player's cash
+        };
+        enum class Street
+        {
+            PRE_FLOP,
+            FLOP,
+            TURN,
+            RIVER,
+            SHOWDOWN
+        };
+
+        class Strategy {
+        public:
+            virtual ~Strategy() = default;
+            virtual Action Act(const Game& game, std::size_t seat) = 0;
+        };
+
+        class Listener {
+        public:
+            virtual ~Listener() = default;
+            virtual void OnStreet(const Game&) {}                            // Cards dealt for game.CurrentStreet()
+            virtual void OnTurn(const Game&, std::size_t) {}                 // A seat is about to act
+            virtual void OnAction(const Game&, std::size_t, Action, int) {}  // A seat's action and the chips it put in the pot
+            virtual void OnRefund(const Game&, std::size_t, int) {}          // Uncalled chips handed back to a seat before a showdown
+            virtual void OnShowdown(const Game&) {}                          // Live hands are about to be compared
+            virtual void OnWin(const Game&, std::size_t, int) {}             // Chips a seat takes from the pot, once per paid seat
+            virtual void OnHandEnd(const Game&) {}                           // Pot awarded, cards not yet cleared
+        };
+
         static const int STARTING_CASH = 500;
+        static const int MAX_PLAYERS = (Card::DECK_SIZE - 8) / 2;  // Everyone's hole cards, the board and three burns from one deck
+
+        // Both throw std::invalid_argument for fewer than two or more than MAX_PLAYERS players
+        Game(int players);                      // Seeded from the clock, Seed() gives the seed that was used
+        Game(int players, std::uint64_t seed);  // Deals the same cards every time given the same actions
+        void SetStrategy(std::size_t seat, Strategy& strategy);     // Seats call everything until given a strategy
+        void SetListener(Listener* listener);                       // nullptr to run headless
+
+        bool PlayHand();                        // False once a single player has all the cash
+        int Winner() const;                     // Seat holding all the cash, -1 while the game is still going
 
+        std::uint64_t Seed() const;
+        std::uint64_t HandNumber() const;       // Hands finished so far, so during a hand it's that hand's number from 0
+        std::size_t Players() const;
+        std::size_t Button() const;
+        std::size_t SmallBlind() const;
+        std::size_t BigBlind() const;
+        Street CurrentStreet() const;
+        const Hand& Hole(std::size_t seat) const;
+        const Hand& Board() const;
+        int Cash(std::size_t seat) const;
+        int Bet(std::size_t seat) const;        // Put in during the current betting round
+        bool InRound(std::size_t seat) const;
+        int CurrentBet() const;
+        int MinimumBet() const;
+        int Pot() const;                        // Collected from earlier betting rounds
+        std::uint32_t Strength(std::size_t seat) const;     // Evaluator strength at the showdown, 0 for folded seats and before it
+
+    private:
+        static Strategy& DefaultStrategy();
+
+        std::uint64_t seed;
+        std::uint64_t handNumber;
         Deck deck;
         std::size_t buttonPos;
         int pot;
         int minimumBet;
+        int currentBet;
+        Street street;
+        std::size_t live;                       // Players still in the hand
 
         std::vector<Hand> hands;
         Hand communityCards;
         std::vector<int> cash;
         std::vector<int> bets;
+        std::vector<int> contributed;           // Put in the pot this hand, bets move here as each betting round ends
+        std::vector<std::uint32_t> strengths;   // Scored once at the showdown
         std::vector<bool> inRound;
+        std::vector<bool> acted;
+        std::vector<Strategy*> strategies;
+        Listener* listener;
 
-    public:
-        Game(int players);
-        void Start();
-
-    private:
         void PlayRound();
         void BettingRound();
+        int Apply(std::size_t seat, Action action);
+        void PostBlind(std::size_t seat, int amount);
+        void Showdown();
+        void Refund();
+        void Award(std::size_t seat, int amount);
         void PlayerDeal();
         void TableDeal(int n);
-        void DrawTable();
-        char GetInput(std::string prompt, std::vector<char> validInputs);
+        void EndHand();
     };
 }
 
-#endif
\ No newline at end of file
+#endif
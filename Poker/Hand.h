@@ -2,25 +2,23 @@
 #define HAND_H
 
 #include "Card.h"
+#include "CardSet.h"
 #include "Deck.h"
 
+#include <array>
 #include <map>
 #include <functional>
 #include <ostream>
 
 namespace Poker {
     class Hand {
+    public:
+        static const std::size_t MAX_CARDS = 7; // Hole cards plus a full board
+
     private:
-        std::vector<Card> cards;
-        std::pair<bool, Card::Rank> StraightFlush() const;                                    // Rank of high card - A for royal flush
-        std::pair<bool, std::pair<Card::Rank, Card::Rank>> FourOfAKind() const;               // Rank of four of a kind, plus rank of kicker
-        std::pair<bool, std::pair<Card::Rank, Card::Rank>> FullHouse() const;                 // Rank of triple, plus rank of pair
-        std::pair<bool, std::vector<Card::Rank>> Flush() const;                               // Ranks of cards
-        std::pair<bool, Card::Rank> Straight() const;                                         // Rank of high card
-        std::pair<bool, std::pair<Card::Rank, std::vector<Card::Rank>>> ThreeOfAKind() const; // Rank of triple, plus rank of kickers
-        std::pair<bool, std::pair<std::vector<Card::Rank>, Card::Rank>> TwoPair() const;      // Ranks of pairs, plus rank of kicker
-        std::pair<bool, std::pair<Card::Rank, std::vector<Card::Rank>>> Pair() const;         // Rank of pair, plus ranks of kickers
-        std::vector<Card::Rank> HighCard() const;                                             // Ranks of cards
+        std::array<std::uint8_t, MAX_CARDS> cards; // Card ids in the order they were drawn
+        std::size_t size;
+        CardSet cardSet;
 
     public:
         enum class Type
@@ -37,11 +35,17 @@ namespace Poker {
         };
         static std::map<Hand::Type, std::function<std::string(std::vector<Card::Rank>)>> TYPE_NAMES;
         Hand();
+        void Add(Card card);                                        // Throws std::length_error past MAX_CARDS
         void Draw(Deck& deck);
         void Draw(Deck& deck, int n);
         void Discard(Deck& deck);
-        std::pair<Type, std::vector<Card::Rank>> Score() const;
-        Hand operator+(const Hand& other);
+        void Clear();
+        CardSet Cards() const;
+        std::size_t Size() const;
+        std::uint32_t Strength() const;                             // Packed Evaluator strength, compares as an integer
+        std::pair<Type, std::vector<Card::Rank>> Score() const;     // Unpacked strength, for display
+        static std::pair<Type, std::vector<Card::Rank>> Score(std::uint32_t strength);  // Unpacks a strength already evaluated
+        Hand operator+(const Hand& other) const;
         friend bool operator<(const Hand& lhs, const Hand& rhs);
         friend bool operator>(const Hand& lhs, const Hand& rhs);
         friend bool operator<=(const Hand& lhs, const Hand& rhs);
@@ -0,0 +1,384 @@
+#include "HandHistory.h"
+#include "Evaluator.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace Poker {
+    namespace {
+        void PutVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<unsigned char>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<unsigned char>(value));
+        }
+
+        // Bounds checked reads from one record
+        struct Cursor {
+            const unsigned char* data;
+            std::size_t size;
+            std::size_t offset;
+
+            std::uint8_t Byte() {
+                if (offset >= size) {
+                    throw std::runtime_error("Hand history is truncated or corrupt");
+                }
+                return data[offset++];
+            }
+
+            std::uint64_t Varint() {
+                std::uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    std::uint8_t byte = Byte();
+                    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80)) {
+                        return value;
+                    }
+                }
+                throw std::runtime_error("Hand history is truncated or corrupt");
+            }
+
+            // Number of entries that follow, each at least entryBytes long, so a corrupt count can't outgrow the record
+            std::size_t Count(std::size_t entryBytes) {
+                std::uint64_t count = Varint();
+                if (count > (size - offset) / entryBytes) {
+                    throw std::runtime_error("Hand history is truncated or corrupt");
+                }
+                return static_cast<std::size_t>(count);
+            }
+
+            Card NextCard() {
+                std::uint8_t id = Byte();
+                if (id >= Card::DECK_SIZE) {
+                    throw std::runtime_error("Hand history is truncated or corrupt");
+                }
+                return Card::FromId(id);
+            }
+        };
+    }
+
+    // ----------------------------   Public   ----------------------------
+    const char HandHistory::MAGIC[8] = { 'H', 'A', 'N', 'D', 'H', 'I', 'S', 'T' };
+
+    std::size_t HandHistory::Record::Players() const {
+        return hole.size();
+    }
+
+    bool HandHistory::Record::Folded(std::size_t seat) const {
+        for (auto& event : events) {
+            if (event.seat == seat && event.action == Game::Action::FOLD) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::uint32_t> HandHistory::Record::Strengths() const {
+        std::vector<std::uint32_t> strengths(hole.size(), 0);
+        for (std::size_t seat = 0; seat < hole.size(); seat++) {
+            if (!hole[seat].Empty() && !Folded(seat)) {
+                strengths[seat] = Evaluator::Evaluate(hole[seat] | board);
+            }
+        }
+        return strengths;
+    }
+
+    HandHistory::Writer::Writer(const std::string& path) : file(path, std::ios::binary | std::ios::trunc), current(), hands(0),
+        buffer({}), pending({}), pendingFull(false), stopping(false), failed(false) {
+        Header header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!file) {
+            throw std::runtime_error("Can't write hand history " + path);
+        }
+        buffer.reserve(BUFFER_SIZE + BUFFER_SIZE / 8);
+        pending.reserve(BUFFER_SIZE + BUFFER_SIZE / 8);
+        flusher = std::thread(&Writer::Run, this);
+    }
+
+    HandHistory::Writer::~Writer() {
+        try {
+            Flush();
+        }
+        catch (const std::runtime_error&) {
+            // Nowhere to report it from a destructor, call Flush first to find out
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        flusher.join();
+    }
+
+    void HandHistory::Writer::OnStreet(const Game& game) {
+        if (game.CurrentStreet() != Game::Street::PRE_FLOP) {
+            return;
+        }
+        // Blinds are posted after this, so cash is still what each seat started the hand with
+        current.gameHand = game.HandNumber();
+        current.seed = game.Seed();
+        current.button = game.Button();
+        current.minimumBet = game.MinimumBet();
+        current.hole.resize(game.Players());
+        current.startingCash.resize(game.Players());
+        for (std::size_t seat = 0; seat < game.Players(); seat++) {
+            current.hole[seat] = game.Hole(seat).Cards();
+            current.startingCash[seat] = game.Cash(seat);
+        }
+        current.board = {};
+        current.events.clear();
+        current.refunds.clear();
+        current.showdown = false;
+        current.wins.clear();
+    }
+
+    void HandHistory::Writer::OnAction(const Game& game, std::size_t seat, Game::Action action, int amount) {
+        current.events.push_back({ static_cast<std::uint8_t>(seat), game.CurrentStreet(), action, amount });
+    }
+
+    void HandHistory::Writer::OnRefund(const Game&, std::size_t seat, int amount) {
+        current.refunds.push_back({ static_cast<std::uint8_t>(seat), amount });
+    }
+
+    void HandHistory::Writer::OnShowdown(const Game&) {
+        current.showdown = true;
+    }
+
+    void HandHistory::Writer::OnWin(const Game&, std::size_t seat, int amount) {
+        current.wins.push_back({ static_cast<std::uint8_t>(seat), amount });
+    }
+
+    void HandHistory::Writer::OnHandEnd(const Game& game) {
+        current.board = game.Board().Cards();
+        current.hand = hands++;
+        Encode(current, buffer);
+        if (buffer.size() >= BUFFER_SIZE) {
+            HandOver();
+        }
+    }
+
+    void HandHistory::Writer::Flush() {
+        if (!buffer.empty()) {
+            HandOver();
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return !pendingFull; });
+        if (failed) {
+            throw std::runtime_error("Can't write hand history");
+        }
+    }
+
+    std::uint64_t HandHistory::Writer::Hands() const {
+        return hands;
+    }
+
+    HandHistory::Reader::Reader(const std::string& path) : file(path), offset(sizeof(Header)), hand(0) {
+        const Header* header = reinterpret_cast<const Header*>(file.Data());
+        if (file.Size() < sizeof(Header) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+            throw std::runtime_error("Not a hand history, or written by a different version: " + path);
+        }
+        file.Sequential();
+    }
+
+    bool HandHistory::Reader::Next(Record& record) {
+        if (offset == file.Size()) {
+            return false;
+        }
+        std::size_t end = RecordEnd();
+        Decode(file.Data() + offset, end - offset, record);
+        record.hand = hand++;
+        offset = end;
+        return true;
+    }
+
+    bool HandHistory::Reader::Skip() {
+        if (offset == file.Size()) {
+            return false;
+        }
+        offset = RecordEnd();
+        hand++;
+        return true;
+    }
+
+    bool HandHistory::Reader::Skip(std::uint64_t& gameHand) {
+        if (offset == file.Size()) {
+            return false;
+        }
+        std::size_t end = RecordEnd();
+        Cursor cursor = { file.Data(), end, offset };
+        gameHand = cursor.Varint();
+        offset = end;
+        hand++;
+        return true;
+    }
+
+    void HandHistory::Reader::Rewind() {
+        offset = sizeof(Header);
+        hand = 0;
+    }
+
+    HandHistory::Reader::Mark HandHistory::Reader::Tell() const {
+        return { offset, hand };
+    }
+
+    void HandHistory::Reader::Seek(const Mark& mark) {
+        offset = mark.offset;
+        hand = mark.hand;
+    }
+
+    std::uint64_t HandHistory::Reader::Position() const {
+        return hand;
+    }
+
+    // ----------------------------  Private  ----------------------------
+    void HandHistory::Writer::HandOver() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return !pendingFull; });
+            std::swap(buffer, pending);
+            pendingFull = true;
+        }
+        changed.notify_all();
+    }
+
+    void HandHistory::Writer::Run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            changed.wait(lock, [this] { return pendingFull || stopping; });
+            if (!pendingFull) {
+                return;
+            }
+            // The game thread leaves pending alone until pendingFull is cleared, so it's written unlocked
+            lock.unlock();
+            file.write(reinterpret_cast<const char*>(pending.data()), pending.size());
+            file.flush();
+            bool written = static_cast<bool>(file);
+            pending.clear();
+            lock.lock();
+            failed = failed || !written;
+            pendingFull = false;
+            changed.notify_all();
+        }
+    }
+
+    std::size_t HandHistory::Reader::RecordEnd() {
+        Cursor cursor = { file.Data(), file.Size(), offset };
+        std::uint64_t length = cursor.Varint();
+        if (length > file.Size() - cursor.offset) {
+            throw std::runtime_error("Hand history is truncated or corrupt");
+        }
+        offset = cursor.offset;
+        return offset + static_cast<std::size_t>(length);
+    }
+
+    void HandHistory::Encode(const Record& record, std::vector<unsigned char>& out) {
+        if (record.Players() > NO_CARD) {
+            throw std::invalid_argument("Hand histories hold at most 255 seats");
+        }
+        std::size_t start = out.size();
+        PutVarint(out, record.gameHand);
+        if (record.gameHand == 0) {
+            for (int shift = 0; shift < 64; shift += 8) {
+                out.push_back(static_cast<unsigned char>(record.seed >> shift));
+            }
+        }
+        out.push_back(static_cast<unsigned char>(record.Players()));
+        out.push_back(static_cast<unsigned char>(record.button));
+        PutVarint(out, record.minimumBet);
+        for (std::size_t seat = 0; seat < record.Players(); seat++) {
+            CardSet hole = record.hole[seat];
+            for (int i = 0; i < 2; i++) {
+                out.push_back(hole.Empty() ? NO_CARD : hole.First().Id());
+                hole -= hole.Empty() ? CardSet() : CardSet(hole.First());
+            }
+            PutVarint(out, record.startingCash[seat]);
+        }
+        out.push_back(static_cast<unsigned char>(record.board.Size()));
+        for (auto card : record.board) {
+            out.push_back(card.Id());
+        }
+        PutVarint(out, record.events.size());
+        for (auto& event : record.events) {
+            out.push_back(event.seat);
+            out.push_back(static_cast<unsigned char>(static_cast<int>(event.street) << 2 | static_cast<int>(event.action)));
+            PutVarint(out, event.amount);
+        }
+        PutVarint(out, record.refunds.size());
+        for (auto& refund : record.refunds) {
+            out.push_back(refund.seat);
+            PutVarint(out, refund.amount);
+        }
+        out.push_back(record.showdown);
+        PutVarint(out, record.wins.size());
+        for (auto& win : record.wins) {
+            out.push_back(win.seat);
+            PutVarint(out, win.amount);
+        }
+
+        // Length prefix goes in front of the body now that its size is known
+        std::vector<unsigned char> prefix = {};
+        PutVarint(prefix, out.size() - start);
+        out.insert(out.begin() + start, prefix.begin(), prefix.end());
+    }
+
+    void HandHistory::Decode(const unsigned char* data, std::size_t size, Record& record) {
+        Cursor cursor = { data, size, 0 };
+        record.gameHand = cursor.Varint();
+        record.seed = 0;
+        if (record.gameHand == 0) {
+            for (int shift = 0; shift < 64; shift += 8) {
+                record.seed |= static_cast<std::uint64_t>(cursor.Byte()) << shift;
+            }
+        }
+        std::size_t players = cursor.Byte();
+        if (players < 2 || players > static_cast<std::size_t>(Game::MAX_PLAYERS)) {
+            throw std::runtime_error("Hand history is truncated or corrupt");
+        }
+        record.button = cursor.Byte();
+        record.minimumBet = static_cast<int>(cursor.Varint());
+        record.hole.resize(players);
+        record.startingCash.resize(players);
+        for (std::size_t seat = 0; seat < players; seat++) {
+            CardSet hole = {};
+            for (int i = 0; i < 2; i++) {
+                if (cursor.offset < size && data[cursor.offset] == NO_CARD) {
+                    cursor.offset++;
+                }
+                else {
+                    hole.Add(cursor.NextCard());
+                }
+            }
+            record.hole[seat] = hole;
+            record.startingCash[seat] = static_cast<int>(cursor.Varint());
+        }
+        record.board = {};
+        for (std::size_t i = cursor.Byte(); i > 0; i--) {
+            record.board.Add(cursor.NextCard());
+        }
+        record.events.resize(cursor.Count(3));     // Seat, street and action, amount
+        for (auto& event : record.events) {
+            event.seat = cursor.Byte();
+            std::uint8_t packed = cursor.Byte();
+            if ((packed >> 2) > static_cast<int>(Game::Street::SHOWDOWN) || (packed & 3) > static_cast<int>(Game::Action::RAISE)) {
+                throw std::runtime_error("Hand history is truncated or corrupt");
+            }
+            event.street = static_cast<Game::Street>(packed >> 2);
+            event.action = static_cast<Game::Action>(packed & 3);
+            event.amount = static_cast<int>(cursor.Varint());
+        }
+        record.refunds.resize(cursor.Count(2));    // Seat, amount
+        for (auto& refund : record.refunds) {
+            refund.seat = cursor.Byte();
+            refund.amount = static_cast<int>(cursor.Varint());
+        }
+        record.showdown = cursor.Byte() != 0;
+        record.wins.resize(cursor.Count(2));       // Seat, amount
+        for (auto& win : record.wins) {
+            win.seat = cursor.Byte();
+            win.amount = static_cast<int>(cursor.Varint());
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef HAND_HISTORY_H
+#define HAND_HISTORY_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CardSet.h"
+#include "Game.h"
+#include "MappedFile.h"
+
+namespace Poker {
+    // Compact binary log of played hands, written by a Game listener and scanned back through a memory map
+    // File: 16 byte header, then one record per hand, prefixed by its length so readers can skip it
+    // Record: hand number within its game (then the game's 8 byte seed when that's 0), players, button, minimum bet,
+    // per seat two hole card ids (0xFF if not dealt) and cash before the blinds, board card ids, actions as (seat, street << 2 | action, amount),
+    // (seat, amount) refunds of uncalled chips, a showdown flag and (seat, amount) wins
+    // Counts and amounts are LEB128 varints, everything else is one byte
+    class HandHistory {
+    public:
+        struct Event {
+            std::uint8_t seat;
+            Game::Street street;
+            Game::Action action;
+            int amount;                         // Put in the pot by the action
+        };
+
+        struct Win {
+            std::uint8_t seat;
+            int amount;
+        };
+
+        struct Record {
+            std::uint64_t hand = 0;             // Position in the log, from 0
+            std::uint64_t gameHand = 0;         // Game::HandNumber(), one log can hold many games back to back
+            std::uint64_t seed = 0;             // Game::Seed(), only recorded on a game's first hand
+            std::size_t button = 0;
+            int minimumBet = 0;
+            std::vector<CardSet> hole;          // Empty for seats that weren't dealt in
+            std::vector<int> startingCash;
+            CardSet board;
+            std::vector<Event> events;
+            std::vector<Win> refunds;           // Uncalled chips handed back, not won
+            bool showdown = false;
+            std::vector<Win> wins;
+
+            std::size_t Players() const;
+            bool Folded(std::size_t seat) const;
+            // Evaluator strength of each seat still in at the end of the hand, 0 for the rest
+            // Reruns the showdown, so a log can be audited against its recorded wins
+            std::vector<std::uint32_t> Strengths() const;
+        };
+
+        // Appends every hand the game plays, encoding on the game thread and writing on a background thread
+        // so play only waits when a full buffer is handed over while the previous one is still being written
+        class Writer : public Game::Listener {
+        public:
+            explicit Writer(const std::string& path);       // Truncates, throws std::runtime_error if it can't
+            ~Writer() override;                             // Flushes
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            void OnStreet(const Game& game) override;
+            void OnAction(const Game& game, std::size_t seat, Game::Action action, int amount) override;
+            void OnRefund(const Game& game, std::size_t seat, int amount) override;
+            void OnShowdown(const Game& game) override;
+            void OnWin(const Game& game, std::size_t seat, int amount) override;
+            void OnHandEnd(const Game& game) override;
+
+            void Flush();                       // Blocks until every finished hand is written, throws std::runtime_error on write failure
+            std::uint64_t Hands() const;
+
+        private:
+            static const std::size_t BUFFER_SIZE = 1 << 20;
+
+            std::ofstream file;
+            Record current;
+            std::uint64_t hands;
+
+            std::vector<unsigned char> buffer;  // Filled by the game thread
+            std::vector<unsigned char> pending; // Owned by the flusher while pendingFull
+            std::mutex mutex;
+            std::condition_variable changed;
+            bool pendingFull;
+            bool stopping;
+            bool failed;
+            std::thread flusher;
+
+            void HandOver();
+            void Run();
+        };
+
+        // Sequential scan of a log, Next decodes into a caller owned record so its vectors are reused
+        class Reader {
+        public:
+            // A place in the log to come back to, from Tell on the same reader
+            struct Mark {
+                std::size_t offset;
+                std::uint64_t hand;
+            };
+
+            explicit Reader(const std::string& path);       // Throws std::runtime_error if it isn't a hand history
+            bool Next(Record& record);          // False at the end of the log, throws std::runtime_error if it's corrupt
+            bool Skip();                        // Past one record without decoding it
+            bool Skip(std::uint64_t& gameHand); // Also decodes the record's Record::gameHand, the first thing in it
+            void Rewind();
+            Mark Tell() const;                  // Where the next record starts
+            void Seek(const Mark& mark);
+            std::uint64_t Position() const;     // Hands read or skipped so far
+
+        private:
+            MappedFile file;
+            std::size_t offset;
+            std::uint64_t hand;
+
+            std::size_t RecordEnd();            // Reads the length prefix
+        };
+
+    private:
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t reserved;
+        };
+
+        static const std::uint32_t VERSION = 3;
+        static const char MAGIC[8];
+        static const std::uint8_t NO_CARD = 0xFF;
+
+        static void Encode(const Record& record, std::vector<unsigned char>& out);
+        static void Decode(const unsigned char* data, std::size_t size, Record& record);
+    };
+}
+
+#endif
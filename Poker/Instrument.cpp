@@ -0,0 +1,191 @@
+#include "Instrument.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace Poker {
+    namespace {
+        const auto START = std::chrono::steady_clock::now();
+
+        const char* const NAMES[Instrument::COUNTERS] = {
+            "evaluate_high_card", "evaluate_pair", "evaluate_two_pair", "evaluate_three_of_a_kind", "evaluate_straight",
+            "evaluate_flush", "evaluate_full_house", "evaluate_four_of_a_kind", "evaluate_straight_flush",
+            "deck_shuffles", "deck_shuffle_ns", "deck_draws", "deck_draw_ns",
+            "hands", "betting_iterations", "showdown_comparisons", "equity_cache_hits", "equity_cache_misses", "allocations"
+        };
+    }
+
+    // One per thread, linked into a list Collect walks
+    // The list is intrusive because operator new counts through here, so registering a thread mustn't allocate
+    struct Instrument::Block {
+        std::array<std::atomic<std::uint64_t>, COUNTERS> counts;
+        Block* previous;
+        Block* next;
+
+        static std::mutex& Mutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+        static Block*& Head() {
+            static Block* head = nullptr;
+            return head;
+        }
+        static std::array<std::uint64_t, COUNTERS>& Retired() {     // Counts of threads that have exited
+            static std::array<std::uint64_t, COUNTERS> retired = {};
+            return retired;
+        }
+
+        Block() : counts(), previous(nullptr), next(nullptr) {
+            std::lock_guard<std::mutex> lock(Mutex());
+            next = Head();
+            if (next) {
+                next->previous = this;
+            }
+            Head() = this;
+        }
+
+        ~Block() {
+            std::lock_guard<std::mutex> lock(Mutex());
+            for (std::size_t i = 0; i < COUNTERS; i++) {
+                Retired()[i] += counts[i].load(std::memory_order_relaxed);
+            }
+            (previous ? previous->next : Head()) = next;
+            if (next) {
+                next->previous = previous;
+            }
+        }
+    };
+
+    // ----------------------------   Public   ----------------------------
+    std::uint64_t Instrument::Snapshot::operator[](Counter counter) const {
+        return counts[static_cast<std::size_t>(counter)];
+    }
+
+    Instrument::Snapshot Instrument::Snapshot::operator-(const Snapshot& earlier) const {
+        Snapshot interval = { seconds - earlier.seconds, {} };
+        for (std::size_t i = 0; i < COUNTERS; i++) {
+            interval.counts[i] = counts[i] - earlier.counts[i];
+        }
+        return interval;
+    }
+
+    void Instrument::Snapshot::Write(std::ostream& out) const {
+        out << "{ \"seconds\": " << seconds;
+        for (std::size_t i = 0; i < COUNTERS; i++) {
+            out << ", \"" << NAMES[i] << "\": " << counts[i];
+        }
+        out << " }\n";
+    }
+
+    Instrument::Snapshot Instrument::Collect() {
+        Snapshot snapshot = { std::chrono::duration<double>(std::chrono::steady_clock::now() - START).count(), {} };
+        std::lock_guard<std::mutex> lock(Block::Mutex());
+        snapshot.counts = Block::Retired();
+        for (Block* block = Block::Head(); block; block = block->next) {
+            for (std::size_t i = 0; i < COUNTERS; i++) {
+                snapshot.counts[i] += block->counts[i].load(std::memory_order_relaxed);
+            }
+        }
+        return snapshot;
+    }
+
+    const char* Instrument::Name(Counter counter) {
+        return NAMES[static_cast<std::size_t>(counter)];
+    }
+
+    Instrument::Reporter::Reporter(std::ostream& out, std::chrono::milliseconds interval) : out(out), interval(interval), stopping(false) {
+        thread = std::thread(&Reporter::Run, this);
+    }
+
+    Instrument::Reporter::~Reporter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        stop.notify_all();
+        thread.join();
+        Collect().Write(out);
+        out.flush();
+    }
+
+    // ----------------------------  Private  ----------------------------
+    void Instrument::Reporter::Run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stop.wait_for(lock, interval, [this] { return stopping; })) {
+            Collect().Write(out);
+            out.flush();
+        }
+    }
+
+    std::atomic<std::uint64_t>* Instrument::Local() {
+        thread_local Block block;
+        return block.counts.data();
+    }
+}
+
+#ifdef POKER_INSTRUMENT
+// Replaced so allocations show up in the counters, only in instrumented builds
+// The array forms call these by default, the nothrow ones are replaced too since they needn't go through the throwing form
+namespace {
+    void* Allocate(std::size_t size, std::size_t alignment) {
+        Poker::Instrument::Add(Poker::Instrument::Counter::ALLOCATIONS);
+        size = size ? size : 1;
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return std::malloc(size);
+        }
+#if defined(_MSC_VER)
+        return _aligned_malloc(size, alignment);
+#else
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);  // A multiple of the alignment
+#endif
+    }
+
+    void Free(void* memory, [[maybe_unused]] std::size_t alignment) {
+#if defined(_MSC_VER)
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            _aligned_free(memory);
+            return;
+        }
+#endif
+        std::free(memory);
+    }
+}
+
+void* operator new(std::size_t size) {
+    if (void* memory = Allocate(size, 0)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* memory = Allocate(size, static_cast<std::size_t>(alignment))) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept {
+    Free(memory, 0);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    Free(memory, 0);
+}
+
+void operator delete(void* memory, std::align_val_t alignment) noexcept {
+    Free(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept {
+    Free(memory, static_cast<std::size_t>(alignment));
+}
+#endif
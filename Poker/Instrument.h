@@ -0,0 +1,119 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+#include "Evaluator.h"
+
+namespace Poker {
+    // Hot path counters, compiled out unless the build defines POKER_INSTRUMENT (the CMake option of the same name)
+    // Each thread counts into its own block, Collect merges them on demand so counting never contends
+    class Instrument {
+    public:
+        enum class Counter
+        {
+            EVALUATE_HIGH_CARD,     // One per evaluation, by the hand type under the evaluation's rules
+            EVALUATE_PAIR,
+            EVALUATE_TWO_PAIR,
+            EVALUATE_THREE_OF_A_KIND,
+            EVALUATE_STRAIGHT,
+            EVALUATE_FLUSH,
+            EVALUATE_FULL_HOUSE,
+            EVALUATE_FOUR_OF_A_KIND,
+            EVALUATE_STRAIGHT_FLUSH,
+            DECK_SHUFFLES,
+            DECK_SHUFFLE_NANOSECONDS,
+            DECK_DRAWS,
+            DECK_DRAW_NANOSECONDS,
+            HANDS,                  // Played by Game
+            BETTING_ITERATIONS,     // Seats visited by Game's betting loop
+            SHOWDOWN_COMPARISONS,
+            EQUITY_CACHE_HITS,
+            EQUITY_CACHE_MISSES,
+            ALLOCATIONS,            // Every operator new, divide by HANDS for allocations per hand
+            COUNT
+        };
+        static const std::size_t COUNTERS = static_cast<std::size_t>(Counter::COUNT);
+
+#ifdef POKER_INSTRUMENT
+        static constexpr bool ENABLED = true;
+#else
+        static constexpr bool ENABLED = false;
+#endif
+
+        struct Snapshot {
+            double seconds;                             // Since the process started
+            std::array<std::uint64_t, COUNTERS> counts;
+
+            std::uint64_t operator[](Counter counter) const;
+            Snapshot operator-(const Snapshot& earlier) const;  // Counts over the interval between two snapshots
+            void Write(std::ostream& out) const;                // One line JSON object
+        };
+
+        // Only ever touches the calling thread's block, a plain load and store rather than a locked add
+        static void Add(Counter counter, std::uint64_t amount = 1) {
+            if constexpr (ENABLED) {
+                std::atomic<std::uint64_t>& count = Local()[static_cast<std::size_t>(counter)];
+                count.store(count.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+            }
+        }
+
+        static void Evaluated(Hand::Type type) {
+            Add(static_cast<Counter>(static_cast<std::size_t>(Counter::EVALUATE_HIGH_CARD) + static_cast<std::size_t>(type)));
+        }
+
+        static Snapshot Collect();                      // Totals over every thread, including ones that have exited
+        static const char* Name(Counter counter);
+
+        // Counts a call and the time it took, the clock reads cost more than a deck draw so only trust relative numbers
+        class Timer {
+        public:
+#ifdef POKER_INSTRUMENT
+            Timer(Counter calls, Counter nanoseconds) : calls(calls), nanoseconds(nanoseconds), start(std::chrono::steady_clock::now()) {}
+            ~Timer() {
+                Add(calls);
+                Add(nanoseconds, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            }
+
+        private:
+            Counter calls;
+            Counter nanoseconds;
+            std::chrono::steady_clock::time_point start;
+#else
+            Timer(Counter, Counter) {}
+#endif
+        };
+
+        // Writes a snapshot to out every interval from a background thread, and a last one when destroyed
+        class Reporter {
+        public:
+            Reporter(std::ostream& out, std::chrono::milliseconds interval);
+            ~Reporter();
+            Reporter(const Reporter&) = delete;
+            Reporter& operator=(const Reporter&) = delete;
+
+        private:
+            std::ostream& out;
+            std::chrono::milliseconds interval;
+            std::mutex mutex;
+            std::condition_variable stop;
+            bool stopping;
+            std::thread thread;
+
+            void Run();
+        };
+
+    private:
+        struct Block;
+        static std::atomic<std::uint64_t>* Local();
+    };
+}
+
+#endif
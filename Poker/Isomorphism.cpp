@@ -0,0 +1,144 @@
+#include "Isomorphism.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Poker {
+    namespace {
+        const int ID_BITS = 6;
+
+        // Calls visit with every subset of size cards from the ids in [next, DECK_SIZE) of available
+        template<typename Visit>
+        void ForEachSubset(CardSet available, std::size_t size, int next, CardSet chosen, Visit& visit) {
+            if (size == 0) {
+                visit(chosen);
+                return;
+            }
+            for (int id = next; id <= Card::DECK_SIZE - static_cast<int>(size); id++) {
+                CardSet card = CardSet::FromId(static_cast<std::uint8_t>(id));
+                if (available.Contains(card)) {
+                    ForEachSubset(available, size - 1, id + 1, chosen | card, visit);
+                }
+            }
+        }
+    }
+
+    // ----------------------------   Public   ----------------------------
+    SuitIsomorphism::Canonical SuitIsomorphism::Canonicalize(CardSet hole, CardSet board) {
+        const int SUITS = Card::SUIT_COUNT;
+
+        // Hole cards decide first, a suit's board cards only break ties
+        std::uint32_t signatures[SUITS];
+        int order[SUITS];
+        for (int suit = 0; suit < SUITS; suit++) {
+            signatures[suit] = static_cast<std::uint32_t>(hole.Suit(static_cast<Card::Suit>(suit))) << Card::RANK_COUNT | board.Suit(static_cast<Card::Suit>(suit));
+            order[suit] = suit;
+        }
+        for (int i = 1; i < SUITS; i++) {
+            for (int j = i; j > 0 && signatures[order[j]] > signatures[order[j - 1]]; j--) {
+                std::swap(order[j], order[j - 1]);
+            }
+        }
+
+        Canonical canonical = { {}, {}, 1 };
+        std::uint32_t runLength = 1;
+        for (int suit = 0; suit < SUITS; suit++) {
+            int shift = suit * Card::RANK_COUNT;
+            canonical.hole |= CardSet(static_cast<std::uint64_t>(hole.Suit(static_cast<Card::Suit>(order[suit]))) << shift);
+            canonical.board |= CardSet(static_cast<std::uint64_t>(board.Suit(static_cast<Card::Suit>(order[suit]))) << shift);
+
+            // Suits with identical cards can swap freely, each run of n divides the 24 relabellings by n!
+            runLength = suit > 0 && signatures[order[suit]] == signatures[order[suit - 1]] ? runLength + 1 : 1;
+            canonical.weight *= runLength;
+        }
+        canonical.weight = 24 / canonical.weight;
+        return canonical;
+    }
+
+    std::vector<CardSet> SuitIsomorphism::CanonicalizeAll(const std::vector<CardSet>& sets) {
+        // Same as Canonicalize with each suit's signature being its masks in every set, compared in order
+        int order[Card::SUIT_COUNT] = { 0, 1, 2, 3 };
+        auto before = [&sets](int lhs, int rhs) {
+            for (auto set : sets) {
+                std::uint16_t left = set.Suit(static_cast<Card::Suit>(lhs));
+                std::uint16_t right = set.Suit(static_cast<Card::Suit>(rhs));
+                if (left != right) {
+                    return left > right;
+                }
+            }
+            return false;
+        };
+        std::stable_sort(std::begin(order), std::end(order), before);
+
+        std::vector<CardSet> canonical(sets.size());
+        for (std::size_t i = 0; i < sets.size(); i++) {
+            for (int suit = 0; suit < Card::SUIT_COUNT; suit++) {
+                canonical[i] |= CardSet(static_cast<std::uint64_t>(sets[i].Suit(static_cast<Card::Suit>(order[suit]))) << suit * Card::RANK_COUNT);
+            }
+        }
+        return canonical;
+    }
+
+    SuitIsomorphism::Indexer::Indexer(std::size_t holeCards, std::size_t boardCards) : holeCards(holeCards), boardCards(boardCards), keys({}) {
+        if (holeCards + boardCards > 64 / ID_BITS) {
+            throw std::invalid_argument("Too many cards to index");
+        }
+
+        // Every situation is a relabelling of one with a canonical hole, so only those need their boards enumerated
+        std::vector<CardSet> holes = {};
+        auto addHole = [&holes](CardSet hole) {
+            if (Canonicalize(hole).hole == hole) {
+                holes.push_back(hole);
+            }
+        };
+        ForEachSubset(CardSet::FullDeck(), holeCards, 0, {}, addHole);
+
+        for (auto hole : holes) {
+            auto addBoard = [this, hole](CardSet board) {
+                Canonical canonical = Canonicalize(hole, board);
+                keys.push_back(Key(canonical.hole, canonical.board));
+            };
+            ForEachSubset(CardSet::FullDeck() - hole, boardCards, 0, {}, addBoard);
+        }
+        std::sort(std::begin(keys), std::end(keys));
+        keys.erase(std::unique(std::begin(keys), std::end(keys)), std::end(keys));
+        keys.shrink_to_fit();
+    }
+
+    std::size_t SuitIsomorphism::Indexer::Size() const {
+        return keys.size();
+    }
+
+    std::size_t SuitIsomorphism::Indexer::Index(CardSet hole, CardSet board) const {
+        if (hole.Size() != static_cast<int>(holeCards) || board.Size() != static_cast<int>(boardCards) || hole.Intersects(board)) {
+            throw std::invalid_argument("Situation doesn't match the indexer's card counts");
+        }
+        Canonical canonical = Canonicalize(hole, board);
+        return std::lower_bound(std::begin(keys), std::end(keys), Key(canonical.hole, canonical.board)) - std::begin(keys);
+    }
+
+    SuitIsomorphism::Canonical SuitIsomorphism::Indexer::Situation(std::size_t index) const {
+        std::uint64_t key = keys.at(index);
+        CardSet hole = {};
+        CardSet board = {};
+        for (std::size_t i = 0; i < boardCards; i++, key >>= ID_BITS) {
+            board.Add(Card::FromId(static_cast<std::uint8_t>(key & ((1 << ID_BITS) - 1))));
+        }
+        for (std::size_t i = 0; i < holeCards; i++, key >>= ID_BITS) {
+            hole.Add(Card::FromId(static_cast<std::uint8_t>(key & ((1 << ID_BITS) - 1))));
+        }
+        return Canonicalize(hole, board);
+    }
+
+    // ----------------------------  Private  ----------------------------
+    std::uint64_t SuitIsomorphism::Indexer::Key(CardSet hole, CardSet board) const {
+        std::uint64_t key = 0;
+        for (auto card : hole) {
+            key = key << ID_BITS | card.Id();
+        }
+        for (auto card : board) {
+            key = key << ID_BITS | card.Id();
+        }
+        return key;
+    }
+}
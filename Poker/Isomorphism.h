@@ -0,0 +1,45 @@
+#ifndef ISOMORPHISM_H
+#define ISOMORPHISM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CardSet.h"
+
+namespace Poker {
+    // Situations that only differ by relabelling suits play identically, this picks one representative of each
+    class SuitIsomorphism {
+    public:
+        struct Canonical {
+            CardSet hole;
+            CardSet board;
+            std::uint32_t weight;   // Raw (hole, board) situations this one stands for, at most 24
+        };
+
+        // Suits are reordered by their (hole, board) ranks, largest first, so clubs always holds the most significant suit
+        static Canonical Canonicalize(CardSet hole, CardSet board = {});
+        // Relabels the suits of several card sets together (every player's hole cards, then the board), earlier sets decide first
+        static std::vector<CardSet> CanonicalizeAll(const std::vector<CardSet>& sets);
+
+        // Dense numbering of every canonical situation with a fixed number of hole and board cards
+        // Built once by enumeration and kept as a sorted key table, so it suits preflop, flop and turn sizes
+        class Indexer {
+        public:
+            Indexer(std::size_t holeCards, std::size_t boardCards);
+
+            std::size_t Size() const;
+            std::size_t Index(CardSet hole, CardSet board = {}) const;    // Canonicalizes first, throws std::invalid_argument for the wrong card counts
+            Canonical Situation(std::size_t index) const;
+
+        private:
+            std::size_t holeCards;
+            std::size_t boardCards;
+            std::vector<std::uint64_t> keys;    // Card ids packed 6 bits each, hole cards in the high bits
+
+            std::uint64_t Key(CardSet hole, CardSet board) const;
+        };
+    };
+}
+
+#endif
@@ -0,0 +1,212 @@
+// LoadTool.cpp : Load generator for the server started by Poker --serve.
+// Usage: LoadTool socket [messages = 10000] [batch = 64] [window = 16] [seed]
+//
+// Sends messages of batch requests, keeping up to window messages in flight on one connection, and reports
+// throughput and the latency of each message from being sent to its response arriving.
+// Most requests evaluate a random seven card hand, every 4th compares two, every 16th simulates a random flop heads-up.
+
+#include "CardSet.h"
+#include "Protocol.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    using Poker::CardSet;
+    using Poker::Protocol;
+    using Clock = std::chrono::steady_clock;
+
+    const std::uint64_t EQUITY_TRIALS = 1000;
+
+    // count cards not in used, added to used
+    CardSet Deal(Poker::Random& random, CardSet& used, int count) {
+        CardSet cards = {};
+        while (count > 0) {
+            CardSet card(std::uint64_t(1) << (random() % 52));
+            if (!used.Intersects(card)) {
+                used |= card;
+                cards |= card;
+                count--;
+            }
+        }
+        return cards;
+    }
+
+    int Connect(const std::string& path) {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("Socket path is too long: " + path);
+        }
+        std::copy(std::begin(path), std::end(path), address.sun_path);
+        int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socket < 0 || connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            if (socket >= 0) {
+                close(socket);
+            }
+            throw std::runtime_error("Can't connect to " + path);
+        }
+        return socket;
+    }
+
+    // Appends one request, returns the size of its OK response payload
+    std::size_t Request(Poker::Random& random, std::size_t index, std::vector<unsigned char>& out) {
+        CardSet used = {};
+        if (index % 16 == 15) {
+            Protocol::Put(out, Protocol::Op::EQUITY);
+            Protocol::Put(out, std::uint8_t(2));
+            Protocol::Put(out, Deal(random, used, 2).mask);
+            Protocol::Put(out, Deal(random, used, 2).mask);
+            Protocol::Put(out, Deal(random, used, 3).mask);
+            Protocol::Put(out, std::uint64_t(0));
+            Protocol::Put(out, EQUITY_TRIALS);
+            Protocol::Put(out, random());
+            return 2 * sizeof(double);
+        }
+        if (index % 4 == 3) {
+            CardSet board = Deal(random, used, 5);
+            Protocol::Put(out, Protocol::Op::COMPARE);
+            Protocol::Put(out, (board | Deal(random, used, 2)).mask);
+            Protocol::Put(out, (board | Deal(random, used, 2)).mask);
+            return sizeof(std::int8_t);
+        }
+        Protocol::Put(out, Protocol::Op::EVALUATE);
+        Protocol::Put(out, Deal(random, used, 7).mask);
+        return sizeof(std::uint32_t);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: LoadTool socket [messages = 10000] [batch = 64] [window = 16] [seed]\n";
+        return 1;
+    }
+    std::uint32_t messages = 10000;
+    std::uint32_t batch = 64;
+    std::uint32_t window = 16;
+    std::uint64_t seed = 0;
+    try {
+        messages = argc > 2 ? std::max(std::stoul(argv[2]), 1ul) : messages;
+        batch = argc > 3 ? std::stoul(argv[3]) : batch;
+        window = argc > 4 ? std::max(std::stoul(argv[4]), 1ul) : window;
+        seed = argc > 5 ? std::stoull(argv[5]) : std::random_device()();
+    }
+    catch (const std::logic_error&) {   // std::stoul's invalid_argument and out_of_range
+        std::cerr << "Messages, batch, window and seed must be whole numbers\n";
+        return 1;
+    }
+
+    int socket = -1;
+    try {
+        socket = Connect(argv[1]);
+    }
+    catch (const std::runtime_error& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+
+    // Expected payload sizes per message, written by the sender before the message goes out
+    std::vector<std::vector<std::size_t>> expected(messages);
+    std::vector<Clock::time_point> sent(messages);
+    std::vector<double> latencies(messages, 0.0);
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::uint32_t inFlight = 0;
+    bool failed = false;
+
+    Clock::time_point start = Clock::now();
+    std::thread sender([&] {
+        Poker::Random random(seed);
+        std::vector<unsigned char> message = {};
+        for (std::uint32_t id = 0; id < messages; id++) {
+            message.clear();
+            Protocol::Put(message, Protocol::Header{ 0, id, batch });
+            for (std::size_t i = 0; i < batch; i++) {
+                expected[id].push_back(Request(random, static_cast<std::size_t>(id) * batch + i, message));
+            }
+            std::uint32_t length = static_cast<std::uint32_t>(message.size() - sizeof(Protocol::Header));
+            std::memcpy(message.data(), &length, sizeof(length));
+
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return inFlight < window || failed; });
+            if (failed) {
+                return;
+            }
+            inFlight++;
+            sent[id] = Clock::now();
+            lock.unlock();
+            if (!Protocol::Send(socket, message.data(), message.size())) {
+                return;
+            }
+        }
+    });
+
+    std::uint64_t bad = 0;
+    std::vector<unsigned char> body = {};
+    for (std::uint32_t received = 0; received < messages; received++) {
+        Protocol::Header header;
+        if (!Protocol::Receive(socket, &header, sizeof(header)) || header.id >= messages) {
+            break;
+        }
+        body.resize(header.length);
+        if (!Protocol::Receive(socket, body.data(), body.size())) {
+            break;
+        }
+        Clock::time_point now = Clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        Protocol::Cursor in(body.data(), body.size());
+        for (std::size_t payload : expected[header.id]) {
+            if (in.Get<Protocol::Status>() != Protocol::Status::OK) {
+                bad++;
+                continue;
+            }
+            for (std::size_t i = 0; i < payload; i++) {
+                in.Get<std::uint8_t>();
+            }
+        }
+        latencies[header.id] = std::chrono::duration<double, std::micro>(now - sent[header.id]).count();
+        inFlight--;
+        changed.notify_one();
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        failed = true;
+    }
+    changed.notify_one();
+    shutdown(socket, SHUT_RDWR);
+    sender.join();
+    close(socket);
+
+    std::uint32_t answered = static_cast<std::uint32_t>(std::count_if(std::begin(latencies), std::end(latencies), [](double latency) { return latency > 0.0; }));
+    if (answered < messages) {
+        std::cerr << "Connection closed after " << answered << " of " << messages << " messages\n";
+        return 1;
+    }
+    std::sort(std::begin(latencies), std::end(latencies));
+    auto percentile = [&](double p) { return latencies[std::min(static_cast<std::size_t>(p * messages), latencies.size() - 1)]; };
+
+    std::cout << messages << " messages of " << batch << " requests, " << window << " in flight, " << elapsed << " s\n";
+    std::cout << "Requests/s: " << static_cast<double>(messages) * batch / elapsed << "\n";
+    std::cout << "Messages/s: " << messages / elapsed << "\n";
+    std::cout << "Latency us: p50 " << percentile(0.50) << ", p99 " << percentile(0.99) << ", max " << latencies.back() << "\n";
+    if (bad > 0) {
+        std::cout << "Rejected requests: " << bad << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef WIN32
+#include <windows.h>
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Poker {
+    // ----------------------------   Public   ----------------------------
+    MappedFile::MappedFile(const std::string& path) : mapping(nullptr), size(0) {
+#ifdef WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Can't open " + path);
+        }
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        HANDLE view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (view != nullptr) {
+            mapping = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(view); // The mapped view keeps the mapping alive
+        }
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            throw std::runtime_error("Can't open " + path);
+        }
+        struct stat status;
+        fstat(file, &status);
+        size = static_cast<std::size_t>(status.st_size);
+        void* view = size ? mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+        close(file);
+        mapping = view == MAP_FAILED ? nullptr : view;
+#endif
+        if (mapping == nullptr) {
+            throw std::runtime_error("Can't map " + path);
+        }
+    }
+
+    MappedFile::~MappedFile() {
+#ifdef WIN32
+        UnmapViewOfFile(mapping);
+#else
+        munmap(const_cast<void*>(mapping), size);
+#endif
+    }
+
+    const unsigned char* MappedFile::Data() const {
+        return static_cast<const unsigned char*>(mapping);
+    }
+
+    std::size_t MappedFile::Size() const {
+        return size;
+    }
+
+    void MappedFile::Sequential() const {
+#ifndef WIN32
+        madvise(const_cast<void*>(mapping), size, MADV_SEQUENTIAL);
+#endif
+    }
+}
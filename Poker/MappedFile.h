@@ -0,0 +1,27 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace Poker {
+    // Read only memory map of a whole file, unmapped on destruction
+    class MappedFile {
+    public:
+        // Throws std::runtime_error if the file can't be opened or mapped (including empty files)
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const unsigned char* Data() const;
+        std::size_t Size() const;
+        void Sequential() const;            // Hint that the file will be read front to back
+
+    private:
+        const void* mapping;
+        std::size_t size;
+    };
+}
+
+#endif
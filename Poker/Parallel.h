@@ -0,0 +1,48 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Poker {
+    // Fork/join helpers for the calculators that split one call across threads, the calling thread always takes a share
+    class Parallel {
+    public:
+        // A configured thread count, 0 meaning all cores, never less than one
+        static unsigned ThreadCount(unsigned threads) {
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+            return std::max(threads, 1u);
+        }
+
+        // Runs work(i) for every i in [0, count) on a thread each, the calling thread runs 0, and returns once all have
+        template<typename Work>
+        static void Fork(std::size_t count, Work work) {
+            std::vector<std::thread> workers = {};
+            for (std::size_t i = 1; i < count; i++) {
+                workers.emplace_back(work, i);
+            }
+            if (count > 0) {
+                work(std::size_t(0));
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        // Splits [0, size) into up to threads chunks of at least minimumChunk and runs work(begin, end) on each through Fork
+        template<typename Work>
+        static void ForRange(std::size_t size, unsigned threads, std::size_t minimumChunk, Work work) {
+            std::size_t chunks = std::max<std::size_t>(std::min<std::size_t>(threads, size / minimumChunk), 1);
+            std::size_t chunk = std::max<std::size_t>((size + chunks - 1) / chunks, 1);
+            Fork((size + chunk - 1) / chunk, [&](std::size_t i) {
+                work(i * chunk, std::min((i + 1) * chunk, size));
+            });
+        }
+    };
+}
+
+#endif
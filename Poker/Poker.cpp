@@ -1,14 +1,40 @@
 ﻿// Poker.cpp : Defines the entry point for the application.
 //
 
+#include "Console.h"
 #include "Game.h"
 #include "Deck.h"
 #include "Hand.h"
+#include "Evaluator.h"
+#include "Server.h"
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 
-int main()
+int main(int argc, char* argv[])
 {
+    // Poker --serve socket [threads]: answers Protocol batches instead of playing, see Server.h
+    if (argc > 2 && std::string(argv[1]) == "--serve") {
+        unsigned threads = 0;
+        try {
+            threads = argc > 3 ? static_cast<unsigned>(std::stoul(argv[3])) : 0u;
+        }
+        catch (const std::logic_error&) {   // std::stoul's invalid_argument and out_of_range
+            std::cerr << "Not a thread count: " << argv[3] << "\n";
+            return 1;
+        }
+        try {
+            Poker::Server server({ argv[2], threads });
+            server.Run();
+        }
+        catch (const std::runtime_error& error) {
+            std::cerr << error.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
     std::cout << R"(################################################################################)" << "\n";
     std::cout << R"(#     /\                                                              _   _    #)" << "\n";
     std::cout << R"(#    <  >                        ___                                 / \_/ \   #)" << "\n";
@@ -30,16 +56,18 @@ int main()
     std::cout << R"(#     \/                                                              /__\     #)" << "\n";
     std::cout << R"(################################################################################)" << "\n";
     //Poker::Game game(4);
-    //game.Start();
+    //Poker::Console console(0);
+    //console.Start(game);
     Poker::Deck deck;
     Poker::Hand hand;
     int c = 0;
     for (int i = 0; i < 1000000; i++) {
         hand.Draw(deck, 7);
-        if (hand.Score().first == Poker::Hand::Type::STRAIGHT) {
+        if (static_cast<Poker::Hand::Type>(hand.Strength() >> Poker::Evaluator::TYPE_SHIFT) == Poker::Hand::Type::STRAIGHT) {
             c++;
         }
-        hand.Discard(deck);
+        hand.Clear();
+        deck.Reset();
     }
     std::cout << 1.0*c/100000;
 
@@ -0,0 +1,110 @@
+#include "Preflop.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace Poker {
+    // ----------------------------   Public   ----------------------------
+    const char PreflopTable::MAGIC[8] = { 'P', 'R', 'E', 'F', 'L', 'O', 'P', '\0' };
+
+    PreflopTable::PreflopTable(const std::string& path) : file(path), matchups(nullptr), classEquity(nullptr), players(0) {
+        const Header* header = reinterpret_cast<const Header*>(file.Data());
+        if (file.Size() < sizeof(Header) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION
+            || header->holdings != HOLDINGS || header->classes != CLASSES || header->players < 2 || header->players > MAX_PLAYERS
+            || file.Size() != Expected(header->players)) {
+            throw std::runtime_error("Not a preflop table, or written by a different version: " + path);
+        }
+        players = header->players;
+        matchups = reinterpret_cast<const float*>(header + 1);
+        classEquity = matchups + HOLDINGS * HOLDINGS;
+    }
+
+    float PreflopTable::Equity(CardSet hero, CardSet villain) const {
+        if (CheckHole(hero).Intersects(CheckHole(villain))) {
+            throw std::invalid_argument("Hands share a card");
+        }
+        return matchups[HoldingIndex(hero) * HOLDINGS + HoldingIndex(villain)];
+    }
+
+    float PreflopTable::Equity(CardSet hero, std::size_t players) const {
+        return ClassEquity(ClassIndex(CheckHole(hero)), players);
+    }
+
+    float PreflopTable::ClassEquity(std::size_t handClass, std::size_t players) const {
+        if (handClass >= CLASSES || players < 2 || players > this->players) {
+            throw std::invalid_argument("No preflop equity for class " + std::to_string(handClass) + " with " + std::to_string(players) + " players");
+        }
+        return classEquity[(players - 2) * CLASSES + handClass];
+    }
+
+    std::size_t PreflopTable::Players() const {
+        return players;
+    }
+
+    std::size_t PreflopTable::HoldingIndex(CardSet hole) {
+        // Colexicographic rank of the two card ids
+        std::size_t low = hole.First().Id();
+        std::size_t high = (hole - CardSet(hole.First())).First().Id();
+        return high * (high - 1) / 2 + low;
+    }
+
+    CardSet PreflopTable::Holding(std::size_t index) {
+        std::size_t high = 1;
+        while ((high + 1) * high / 2 <= index) {
+            high++;
+        }
+        return CardSet::FromId(static_cast<std::uint8_t>(high)) | CardSet::FromId(static_cast<std::uint8_t>(index - high * (high - 1) / 2));
+    }
+
+    std::size_t PreflopTable::ClassIndex(CardSet hole) {
+        Card first = hole.First();
+        Card second = (hole - CardSet(first)).First();
+        std::size_t high = static_cast<std::size_t>(std::max(first.rank, second.rank)) - static_cast<std::size_t>(Card::Rank::TWO);
+        std::size_t low = static_cast<std::size_t>(std::min(first.rank, second.rank)) - static_cast<std::size_t>(Card::Rank::TWO);
+        return first.suit == second.suit ? high * Card::RANK_COUNT + low : low * Card::RANK_COUNT + high;
+    }
+
+    std::string PreflopTable::ClassName(std::size_t handClass) {
+        const char* RANKS = "23456789TJQKA";
+        std::size_t row = handClass / Card::RANK_COUNT;
+        std::size_t column = handClass % Card::RANK_COUNT;
+        if (row == column) {
+            return { RANKS[row], RANKS[column] };
+        }
+        return { RANKS[std::max(row, column)], RANKS[std::min(row, column)], row > column ? 's' : 'o' };
+    }
+
+    void PreflopTable::Write(const std::string& path, const std::vector<float>& matchups, const std::vector<float>& classEquity, std::size_t players) {
+        if (matchups.size() != HOLDINGS * HOLDINGS || players < 2 || players > MAX_PLAYERS || classEquity.size() != (players - 1) * CLASSES) {
+            throw std::invalid_argument("Preflop tables have the wrong shape");
+        }
+        Header header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.holdings = HOLDINGS;
+        header.classes = CLASSES;
+        header.players = static_cast<std::uint32_t>(players);
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(matchups.data()), matchups.size() * sizeof(float));
+        file.write(reinterpret_cast<const char*>(classEquity.data()), classEquity.size() * sizeof(float));
+        if (!file) {
+            throw std::runtime_error("Can't write preflop table " + path);
+        }
+    }
+
+    // ----------------------------  Private  ----------------------------
+    std::size_t PreflopTable::Expected(std::size_t players) {
+        return sizeof(Header) + (HOLDINGS * HOLDINGS + (players - 1) * CLASSES) * sizeof(float);
+    }
+
+    CardSet PreflopTable::CheckHole(CardSet hole) {
+        if (hole.Size() != 2) {
+            throw std::invalid_argument("Preflop hands have exactly two cards");
+        }
+        return hole;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef PREFLOP_H
+#define PREFLOP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CardSet.h"
+#include "MappedFile.h"
+
+namespace Poker {
+    // Precomputed all-in preflop equities, memory mapped from a file written by PreflopTool
+    // Heads-up matchups for every pair of holdings are exact, as is each starting hand against one random hand
+    // Against two or more random hands they're Monte Carlo estimates
+    class PreflopTable {
+    public:
+        static const std::size_t HOLDINGS = Card::DECK_SIZE * (Card::DECK_SIZE - 1) / 2;  // 1326 two card hands
+        static const std::size_t CLASSES = Card::RANK_COUNT * Card::RANK_COUNT;           // 169 up to suit symmetry
+        static const std::size_t MAX_PLAYERS = 10;
+
+        // Throws std::runtime_error if the file can't be mapped or wasn't written by a matching PreflopTool
+        explicit PreflopTable(const std::string& path);
+
+        float Equity(CardSet hero, CardSet villain) const;          // Heads-up, the hands must not share a card
+        float Equity(CardSet hero, std::size_t players) const;      // Against players - 1 random hands
+        float ClassEquity(std::size_t handClass, std::size_t players) const;
+        std::size_t Players() const;                                // Largest table size stored
+
+        // Dense index of a two card hand in [0, HOLDINGS)
+        static std::size_t HoldingIndex(CardSet hole);
+        static CardSet Holding(std::size_t index);
+        // 13x13 grid, pairs on the diagonal, suited above it and offsuit below, indexed by (high rank, low rank)
+        static std::size_t ClassIndex(CardSet hole);
+        static std::string ClassName(std::size_t handClass);        // "AA", "AKs", "72o"
+
+        // Used by PreflopTool, matchups is HOLDINGS x HOLDINGS and classEquity is (players - 1) x CLASSES from 2 players up
+        static void Write(const std::string& path, const std::vector<float>& matchups, const std::vector<float>& classEquity, std::size_t players);
+
+    private:
+        // Native byte order, the floats follow the header directly
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t holdings;
+            std::uint32_t classes;
+            std::uint32_t players;
+        };
+
+        static const std::uint32_t VERSION = 1;
+        static const char MAGIC[8];
+
+        MappedFile file;
+        const float* matchups;
+        const float* classEquity;
+        std::size_t players;
+
+        static std::size_t Expected(std::size_t players);   // File size in bytes
+        static CardSet CheckHole(CardSet hole);
+    };
+}
+
+#endif
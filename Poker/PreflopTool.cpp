@@ -0,0 +1,177 @@
+// PreflopTool.cpp : Generates the tables behind PreflopTable.
+// Usage: PreflopTool output.bin [players = 10] [multiway trials = 1000000] [seed]
+//
+// Heads-up matchups are enumerated exactly, once per matchup that differs up to suit relabelling.
+// Each starting hand against one random hand is averaged from the matchups, every one is equally likely and has the same number of boards.
+// Larger tables are seeded Monte Carlo, there are too many opponent hands to enumerate.
+
+#include "Deck.h"
+#include "Equity.h"
+#include "Evaluator.h"
+#include "Isomorphism.h"
+#include "Preflop.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    using Poker::Card;
+    using Poker::CardSet;
+    using Poker::PreflopTable;
+
+    const std::size_t BOARD_SIZE = Poker::Equity::BOARD_SIZE;
+
+    // Same key for matchups that only differ by suit names, the villain's cards take the place of a board
+    std::pair<std::uint64_t, std::uint64_t> Relabel(CardSet hero, CardSet villain) {
+        auto canonical = Poker::SuitIsomorphism::Canonicalize(hero, villain);
+        return { canonical.hole.mask, canonical.board.mask };
+    }
+
+    // Also folds each matchup onto its mirror image, flipped says the key is from the villain's side
+    std::pair<std::uint64_t, std::uint64_t> Canonical(CardSet hero, CardSet villain, bool& flipped) {
+        auto key = Relabel(hero, villain);
+        auto mirror = Relabel(villain, hero);
+        flipped = mirror < key;
+        return flipped ? mirror : key;
+    }
+
+    std::vector<float> Matchups() {
+        const std::size_t HOLDINGS = PreflopTable::HOLDINGS;
+        std::vector<float> matchups(HOLDINGS * HOLDINGS, 0.0f);
+        std::map<std::pair<std::uint64_t, std::uint64_t>, float> enumerated = {};
+
+        for (std::size_t hero = 0; hero < HOLDINGS; hero++) {
+            CardSet heroCards = PreflopTable::Holding(hero);
+            for (std::size_t villain = hero + 1; villain < HOLDINGS; villain++) {
+                CardSet villainCards = PreflopTable::Holding(villain);
+                if (heroCards.Intersects(villainCards)) {
+                    continue;
+                }
+                bool flipped;
+                auto key = Canonical(heroCards, villainCards, flipped);
+                auto found = enumerated.find(key);
+                if (found == std::end(enumerated)) {
+                    CardSet first = flipped ? villainCards : heroCards;
+                    CardSet second = flipped ? heroCards : villainCards;
+                    found = enumerated.emplace(key, static_cast<float>(Poker::Equity({ first, second }).Enumerate().equity[0])).first;
+                }
+                float equity = flipped ? 1.0f - found->second : found->second;
+                matchups[hero * HOLDINGS + villain] = equity;
+                matchups[villain * HOLDINGS + hero] = 1.0f - equity;
+            }
+            std::cerr << "\rHeads-up " << hero + 1 << "/" << HOLDINGS << ", " << enumerated.size() << " distinct matchups" << std::flush;
+        }
+        std::cerr << "\n";
+        return matchups;
+    }
+
+    // Mean of each class's matchups against every hand that doesn't share a card
+    std::vector<float> HeadsUpClasses(const std::vector<float>& matchups) {
+        std::vector<double> total(PreflopTable::CLASSES, 0.0);
+        std::vector<std::uint64_t> count(PreflopTable::CLASSES, 0);
+        for (std::size_t hero = 0; hero < PreflopTable::HOLDINGS; hero++) {
+            CardSet heroCards = PreflopTable::Holding(hero);
+            std::size_t handClass = PreflopTable::ClassIndex(heroCards);
+            for (std::size_t villain = 0; villain < PreflopTable::HOLDINGS; villain++) {
+                if (!heroCards.Intersects(PreflopTable::Holding(villain))) {
+                    total[handClass] += matchups[hero * PreflopTable::HOLDINGS + villain];
+                    count[handClass]++;
+                }
+            }
+        }
+        std::vector<float> equity(PreflopTable::CLASSES);
+        for (std::size_t handClass = 0; handClass < PreflopTable::CLASSES; handClass++) {
+            equity[handClass] = static_cast<float>(total[handClass] / count[handClass]);
+        }
+        return equity;
+    }
+
+    float Multiway(CardSet hero, std::size_t players, std::uint64_t trials, Poker::Random rng) {
+        Poker::Deck deck(rng);
+        deck.Remove(hero);
+        double equity = 0;
+        for (std::uint64_t trial = 0; trial < trials; trial++) {
+            deck.Reset();
+            CardSet board = {};
+            for (std::size_t i = 0; i < BOARD_SIZE; i++) {
+                board.Add(deck.Draw());
+            }
+            std::uint32_t heroStrength = Poker::Evaluator::Evaluate(hero | board);
+            std::size_t sharers = 1;
+            bool lost = false;
+            for (std::size_t opponent = 1; opponent < players && !lost; opponent++) {
+                CardSet opponentCards = CardSet(deck.Draw()) | CardSet(deck.Draw());
+                std::uint32_t strength = Poker::Evaluator::Evaluate(opponentCards | board);
+                lost = strength > heroStrength;
+                sharers += strength == heroStrength;
+            }
+            equity += lost ? 0.0 : 1.0 / sharers;
+        }
+        return static_cast<float>(equity / trials);
+    }
+
+    // Any holding of the class stands for all of them
+    CardSet Representative(std::size_t handClass) {
+        std::size_t row = handClass / Card::RANK_COUNT;
+        std::size_t column = handClass % Card::RANK_COUNT;
+        auto rank = [](std::size_t index) { return static_cast<Card::Rank>(index + static_cast<std::size_t>(Card::Rank::TWO)); };
+        Card::Suit second = row > column ? Card::Suit::CLUBS : Card::Suit::DIAMONDS;
+        return CardSet(Card(rank(row), Card::Suit::CLUBS)) | CardSet(Card(rank(column), second));
+    }
+
+    std::vector<float> MultiwayClasses(std::size_t maxPlayers, std::uint64_t trials, std::uint64_t seed) {
+        const std::size_t CLASSES = PreflopTable::CLASSES;
+        std::vector<float> equity((maxPlayers - 2) * CLASSES, 0.0f);
+        std::atomic<std::size_t> next = 0;
+        auto work = [&] {
+            for (std::size_t entry = next++; entry < equity.size(); entry = next++) {
+                std::size_t players = entry / CLASSES + 3;
+                std::size_t handClass = entry % CLASSES;
+                equity[entry] = Multiway(Representative(handClass), players, trials, Poker::Random(seed, entry));
+            }
+        };
+
+        std::vector<std::thread> workers = {};
+        for (unsigned i = 1; i < std::max(std::thread::hardware_concurrency(), 1u); i++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return equity;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: PreflopTool output.bin [players = 10] [multiway trials = 1000000] [seed]\n";
+        return 1;
+    }
+    std::string outputPath = argv[1];
+    std::size_t players = argc > 2 ? std::stoul(argv[2]) : PreflopTable::MAX_PLAYERS;
+    std::uint64_t trials = argc > 3 ? std::stoull(argv[3]) : 1000000;
+    std::uint64_t seed = argc > 4 ? std::stoull(argv[4]) : 0;
+    if (players < 2 || players > PreflopTable::MAX_PLAYERS) {
+        std::cerr << "Players must be between 2 and " << PreflopTable::MAX_PLAYERS << "\n";
+        return 1;
+    }
+
+    std::vector<float> matchups = Matchups();
+    std::vector<float> classEquity = HeadsUpClasses(matchups);
+    std::vector<float> multiway = MultiwayClasses(players, trials, seed);
+    classEquity.insert(std::end(classEquity), std::begin(multiway), std::end(multiway));
+
+    PreflopTable::Write(outputPath, matchups, classEquity, players);
+    std::cout << "Preflop tables for up to " << players << " players written to " << outputPath << "\n";
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "Protocol.h"
+
+#ifndef WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // No per call flag on macOS, broken pipes there need SIGPIPE ignored
+#endif
+#endif
+
+namespace Poker {
+    // ----------------------------   Public   ----------------------------
+#ifndef WIN32
+    bool Protocol::Receive(int socket, void* data, std::size_t size) {
+        unsigned char* next = static_cast<unsigned char*>(data);
+        while (size > 0) {
+            ssize_t received = recv(socket, next, size, 0);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                return false;
+            }
+            next += received;
+            size -= static_cast<std::size_t>(received);
+        }
+        return true;
+    }
+
+    bool Protocol::Send(int socket, const void* data, std::size_t size) {
+        const unsigned char* next = static_cast<const unsigned char*>(data);
+        while (size > 0) {
+            ssize_t sent = send(socket, next, size, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent <= 0) {
+                return false;
+            }
+            next += sent;
+            size -= static_cast<std::size_t>(sent);
+        }
+        return true;
+    }
+#else
+    bool Protocol::Receive(int socket, void* data, std::size_t size) {
+        return false;
+    }
+
+    bool Protocol::Send(int socket, const void* data, std::size_t size) {
+        return false;
+    }
+#endif
+}
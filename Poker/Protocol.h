@@ -0,0 +1,81 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace Poker {
+    // Batch protocol Server speaks over a Unix domain socket, in native byte order since both ends share a machine
+    // A message is a Header then count requests (or responses) back to back. Responses carry their request message's id
+    // and are sent as each message finishes, so a client can pipeline many messages without waiting
+    // Requests are an op byte then its operands, responses a status byte then, when OK, the result:
+    //   EVALUATE  cards:u64                                                    -> strength:u32
+    //   COMPARE   first:u64 second:u64                                         -> sign:i8, 1 when first is stronger
+    //   EQUITY    players:u8 hole:u64 x players board:u64 dead:u64 trials:u64 seed:u64, 0 trials enumerates
+    //                                                                          -> equity:f64 x players
+    //             trials are at most MAX_TRIALS, so one request can't hold a worker for long
+    // Cards are CardSet masks. A request the engine rejects is answered BAD_REQUEST, a malformed message closes the connection
+    class Protocol {
+    public:
+        enum class Op : std::uint8_t
+        {
+            EVALUATE,
+            COMPARE,
+            EQUITY
+        };
+        enum class Status : std::uint8_t
+        {
+            OK,
+            BAD_REQUEST
+        };
+
+        struct Header {
+            std::uint32_t length;               // Bytes after the header
+            std::uint32_t id;                   // Chosen by the client, echoed in the response
+            std::uint32_t count;                // Requests or responses in the message
+        };
+
+        static const std::uint32_t MAX_LENGTH = 1 << 24;
+        static const std::uint64_t MAX_TRIALS = 1 << 24;       // Per EQUITY request, seconds on one worker
+
+        template<typename T>
+        static void Put(std::vector<unsigned char>& out, T value) {
+            std::size_t at = out.size();
+            out.resize(at + sizeof(T));
+            std::memcpy(out.data() + at, &value, sizeof(T));
+        }
+
+        // Reads values from a received body, throws std::runtime_error when it runs out
+        class Cursor {
+        public:
+            Cursor(const unsigned char* data, std::size_t size) : data(data), size(size), offset(0) {}
+
+            template<typename T>
+            T Get() {
+                if (size - offset < sizeof(T)) {
+                    throw std::runtime_error("Message is shorter than its requests");
+                }
+                T value;
+                std::memcpy(&value, data + offset, sizeof(T));
+                offset += sizeof(T);
+                return value;
+            }
+
+            bool Done() const { return offset == size; }
+
+        private:
+            const unsigned char* data;
+            std::size_t size;
+            std::size_t offset;
+        };
+
+        // Whole buffers over a socket, false once the other end has gone
+        static bool Receive(int socket, void* data, std::size_t size);
+        static bool Send(int socket, const void* data, std::size_t size);
+    };
+}
+
+#endif
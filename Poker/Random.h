@@ -0,0 +1,61 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+namespace Poker {
+    // xoshiro256** generator, satisfies UniformRandomBitGenerator
+    // Seeded through SplitMix64 so any 64 bit seed (and stream number) gives a well mixed state
+    class Random {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit Random(std::uint64_t seed, std::uint64_t stream = 0) {
+            Seed(seed, stream);
+        }
+
+        void Seed(std::uint64_t seed, std::uint64_t stream = 0) {
+            std::uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03);
+            for (auto& word : state) {
+                word = SplitMix64(x);
+            }
+        }
+
+        static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            const std::uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+            const std::uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = RotateLeft(state[3], 45);
+            return result;
+        }
+
+        // Uniform integer in [0, bound) by multiply-shift, bias is below bound / 2^32
+        std::uint32_t Bounded(std::uint32_t bound) {
+            return static_cast<std::uint32_t>(((*this)() >> 32) * bound >> 32);
+        }
+
+    private:
+        std::uint64_t state[4];
+
+        static std::uint64_t RotateLeft(std::uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        static std::uint64_t SplitMix64(std::uint64_t& x) {
+            std::uint64_t z = (x += 0x9E3779B97F4A7C15);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            return z ^ (z >> 31);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,204 @@
+#include "Range.h"
+#include "Preflop.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+namespace Poker {
+    namespace {
+        const std::string RANK_CHARACTERS = "23456789TJQKA";
+        const std::string SUIT_CHARACTERS = "cdhs";
+
+        enum class Kind
+        {
+            PAIR,
+            SUITED,
+            OFFSUIT,
+            ANY     // Suited and offsuit
+        };
+
+        // A 169 style class, high and low are rank offsets from TWO
+        struct Class {
+            int high;
+            int low;
+            Kind kind;
+        };
+
+        int ParseRank(char c) {
+            std::size_t rank = RANK_CHARACTERS.find(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+            if (rank == std::string::npos) {
+                throw std::invalid_argument(std::string("Unknown rank ") + c);
+            }
+            return static_cast<int>(rank);
+        }
+
+        Card ParseCard(char rank, char suit) {
+            std::size_t suitIndex = SUIT_CHARACTERS.find(static_cast<char>(std::tolower(static_cast<unsigned char>(suit))));
+            if (suitIndex == std::string::npos) {
+                throw std::invalid_argument(std::string("Unknown suit ") + suit);
+            }
+            return Card(static_cast<Card::Rank>(ParseRank(rank) + static_cast<int>(Card::Rank::TWO)), static_cast<Card::Suit>(suitIndex));
+        }
+
+        Class ParseClass(const std::string& text) {
+            if (text.size() < 2 || text.size() > 3) {
+                throw std::invalid_argument("Can't read hand " + text);
+            }
+            int first = ParseRank(text[0]);
+            int second = ParseRank(text[1]);
+            Class parsed = { std::max(first, second), std::min(first, second), Kind::ANY };
+            if (first == second) {
+                parsed.kind = Kind::PAIR;
+            }
+            if (text.size() == 3) {
+                char kind = static_cast<char>(std::tolower(static_cast<unsigned char>(text[2])));
+                if (parsed.kind == Kind::PAIR || (kind != 's' && kind != 'o')) {
+                    throw std::invalid_argument("Can't read hand " + text);
+                }
+                parsed.kind = kind == 's' ? Kind::SUITED : Kind::OFFSUIT;
+            }
+            return parsed;
+        }
+
+        void SetClass(const Class& handClass, double weight, Range& range) {
+            for (int firstSuit = 0; firstSuit < Card::SUIT_COUNT; firstSuit++) {
+                for (int secondSuit = 0; secondSuit < Card::SUIT_COUNT; secondSuit++) {
+                    bool suited = firstSuit == secondSuit;
+                    if ((handClass.kind == Kind::PAIR && secondSuit <= firstSuit) || (handClass.kind == Kind::SUITED && !suited) || (handClass.kind == Kind::OFFSUIT && suited)) {
+                        continue;
+                    }
+                    Card high(static_cast<Card::Rank>(handClass.high + static_cast<int>(Card::Rank::TWO)), static_cast<Card::Suit>(firstSuit));
+                    Card low(static_cast<Card::Rank>(handClass.low + static_cast<int>(Card::Rank::TWO)), static_cast<Card::Suit>(secondSuit));
+                    range.Set(CardSet(high) | CardSet(low), weight);
+                }
+            }
+        }
+
+        std::string Trim(const std::string& text) {
+            auto first = std::find_if_not(std::begin(text), std::end(text), [](unsigned char c) { return std::isspace(c); });
+            auto last = std::find_if_not(std::rbegin(text), std::rend(text), [](unsigned char c) { return std::isspace(c); }).base();
+            return first < last ? std::string(first, last) : std::string();
+        }
+    }
+
+    // ----------------------------   Public   ----------------------------
+    Range::Range() : weights(HOLDINGS, 0.0) {}
+
+    Range Range::Full() {
+        Range range;
+        std::fill(std::begin(range.weights), std::end(range.weights), 1.0);
+        return range;
+    }
+
+    Range Range::Parse(const std::string& text) {
+        Range range;
+        std::stringstream entries(text);
+        std::string entry;
+        while (std::getline(entries, entry, ',')) {
+            entry = Trim(entry);
+            if (entry.empty()) {
+                continue;
+            }
+            double weight = 1.0;
+            std::size_t colon = entry.find(':');
+            if (colon != std::string::npos) {
+                try {
+                    weight = std::stod(entry.substr(colon + 1));
+                }
+                catch (const std::exception&) {
+                    throw std::invalid_argument("Can't read weight in " + entry);
+                }
+                if (weight < 0) {
+                    throw std::invalid_argument("Negative weight in " + entry);
+                }
+                entry = Trim(entry.substr(0, colon));
+            }
+            ParseEntry(entry, weight, range);
+        }
+        return range;
+    }
+
+    void Range::Set(CardSet hole, double weight) {
+        if (hole.Size() != 2) {
+            throw std::invalid_argument("Range holdings have exactly two cards");
+        }
+        weights[PreflopTable::HoldingIndex(hole)] = weight;
+    }
+
+    double Range::Weight(CardSet hole) const {
+        return weights[PreflopTable::HoldingIndex(hole)];
+    }
+
+    double Range::Weight(std::size_t holding) const {
+        return weights[holding];
+    }
+
+    void Range::Remove(CardSet dead) {
+        for (std::size_t holding = 0; holding < HOLDINGS; holding++) {
+            if (PreflopTable::Holding(holding).Intersects(dead)) {
+                weights[holding] = 0.0;
+            }
+        }
+    }
+
+    std::size_t Range::Combos() const {
+        return std::count_if(std::begin(weights), std::end(weights), [](double weight) { return weight > 0; });
+    }
+
+    double Range::TotalWeight() const {
+        double total = 0;
+        for (double weight : weights) {
+            total += weight;
+        }
+        return total;
+    }
+
+    // ----------------------------  Private  ----------------------------
+    void Range::ParseEntry(const std::string& entry, double weight, Range& range) {
+        // Specific holding, "AhKh"
+        if (entry.size() == 4 && SUIT_CHARACTERS.find(static_cast<char>(std::tolower(static_cast<unsigned char>(entry[1])))) != std::string::npos) {
+            CardSet hole = CardSet(ParseCard(entry[0], entry[1])) | CardSet(ParseCard(entry[2], entry[3]));
+            if (hole.Size() != 2) {
+                throw std::invalid_argument("Holding uses the same card twice: " + entry);
+            }
+            range.Set(hole, weight);
+            return;
+        }
+
+        // Span between two classes of the same kind, "99-66" or "A5s-A2s"
+        std::size_t dash = entry.find('-');
+        if (dash != std::string::npos) {
+            Class from = ParseClass(Trim(entry.substr(0, dash)));
+            Class to = ParseClass(Trim(entry.substr(dash + 1)));
+            if (from.kind != to.kind || (from.kind != Kind::PAIR && from.high != to.high)) {
+                throw std::invalid_argument("Range ends don't match: " + entry);
+            }
+            int lowest = from.kind == Kind::PAIR ? std::min(from.high, to.high) : std::min(from.low, to.low);
+            int highest = from.kind == Kind::PAIR ? std::max(from.high, to.high) : std::max(from.low, to.low);
+            for (int rank = lowest; rank <= highest; rank++) {
+                SetClass(from.kind == Kind::PAIR ? Class{ rank, rank, Kind::PAIR } : Class{ from.high, rank, from.kind }, weight, range);
+            }
+            return;
+        }
+
+        // This class and better, "QQ+" up to aces or "ATs+" up to the kicker below the high card
+        if (!entry.empty() && entry.back() == '+') {
+            Class from = ParseClass(entry.substr(0, entry.size() - 1));
+            if (from.kind == Kind::PAIR) {
+                for (int rank = from.high; rank < Card::RANK_COUNT; rank++) {
+                    SetClass({ rank, rank, Kind::PAIR }, weight, range);
+                }
+            }
+            else {
+                for (int rank = from.low; rank < from.high; rank++) {
+                    SetClass({ from.high, rank, from.kind }, weight, range);
+                }
+            }
+            return;
+        }
+
+        SetClass(ParseClass(entry), weight, range);
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef RANGE_H
+#define RANGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CardSet.h"
+
+namespace Poker {
+    // Weighted set of two card holdings, indexed like PreflopTable::HoldingIndex
+    class Range {
+    public:
+        static const std::size_t HOLDINGS = Card::DECK_SIZE * (Card::DECK_SIZE - 1) / 2;
+
+        Range();                                    // Empty
+        static Range Full();                        // Every holding at weight 1
+
+        // Comma separated standard notation, each entry optionally followed by :weight (default 1)
+        // "AA", "AKs", "AKo", "AK", "QQ+", "ATs+", "KTo+", "99-66", "A5s-A2s", "AhKh", e.g. "QQ+, AKs, A5s-A2s:0.5, KQo"
+        // Throws std::invalid_argument on anything else, later entries overwrite the weights of earlier ones
+        static Range Parse(const std::string& text);
+
+        void Set(CardSet hole, double weight);
+        double Weight(CardSet hole) const;
+        double Weight(std::size_t holding) const;
+        void Remove(CardSet dead);                  // Zero every holding that uses a dead card
+        std::size_t Combos() const;                 // Holdings with non zero weight
+        double TotalWeight() const;
+
+    private:
+        std::vector<double> weights;
+
+        static void ParseEntry(const std::string& entry, double weight, Range& range);
+    };
+}
+
+#endif
@@ -0,0 +1,206 @@
+#include "RangeEquity.h"
+#include "Evaluator.h"
+#include "Parallel.h"
+#include "Preflop.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace Poker {
+    namespace {
+        const std::size_t BOARD_SIZE = 5;
+    }
+
+    // ----------------------------   Public   ----------------------------
+    RangeEquity::RangeEquity(Range hero, Range villain, CardSet board, CardSet dead) : hero(hero), villain(villain), board(board), remaining({}), holdings({}), holes({}) {
+        if (board.Size() > static_cast<int>(BOARD_SIZE)) {
+            throw std::invalid_argument("Board has more than five cards");
+        }
+        if (board.Intersects(dead)) {
+            throw std::invalid_argument("The same card is dealt more than once");
+        }
+
+        this->hero.Remove(board | dead);
+        this->villain.Remove(board | dead);
+        if (this->hero.Combos() == 0 || this->villain.Combos() == 0) {
+            throw std::invalid_argument("Range is empty once board and dead cards are removed");
+        }
+
+        for (std::size_t holding = 0; holding < Range::HOLDINGS; holding++) {
+            holes.push_back(PreflopTable::Holding(holding));
+            if (this->hero.Weight(holding) > 0 || this->villain.Weight(holding) > 0) {
+                holdings.push_back(static_cast<std::uint16_t>(holding));
+            }
+        }
+        for (auto card : CardSet::FullDeck() - board - dead) {
+            remaining.push_back(card.Id());
+        }
+    }
+
+    RangeEquity::Result RangeEquity::Simulate(std::uint64_t boards, std::uint64_t seed, unsigned threads) const {
+        const std::uint64_t chunks = (boards + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        const std::size_t needed = BOARD_SIZE - board.Size();
+
+        std::atomic<std::uint64_t> nextChunk = 0;
+        std::vector<Tally> tallies(Parallel::ThreadCount(threads));
+        auto work = [&](Tally& tally) {
+            Scratch scratch = {};
+            std::vector<std::uint8_t> deck = {};
+            for (std::uint64_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++) {
+                deck = remaining;
+                Random rng(seed, chunk);
+                std::uint64_t chunkBoards = std::min(CHUNK_SIZE, boards - chunk * CHUNK_SIZE);
+                for (std::uint64_t trial = 0; trial < chunkBoards; trial++) {
+                    CardSet fullBoard = board;
+                    for (std::size_t i = 0; i < needed; i++) {
+                        std::size_t j = i + rng.Bounded(static_cast<std::uint32_t>(deck.size() - i));
+                        std::swap(deck[i], deck[j]);
+                        fullBoard |= CardSet::FromId(deck[i]);
+                    }
+                    Showdown(fullBoard, tally, scratch);
+                }
+            }
+        };
+
+        Parallel::Fork(tallies.size(), [&](std::size_t i) { work(tallies[i]); });
+
+        for (std::size_t i = 1; i < tallies.size(); i++) {
+            tallies[0].Add(tallies[i]);
+        }
+        return Summarise(tallies[0], boards);
+    }
+
+    RangeEquity::Result RangeEquity::Enumerate(unsigned threads) const {
+        const std::size_t needed = BOARD_SIZE - board.Size();
+
+        std::vector<Tally> tallies(Parallel::ThreadCount(threads));
+        if (needed == 0) {
+            Scratch scratch = {};
+            Showdown(board, tallies[0], scratch);
+            return Summarise(tallies[0], 1);
+        }
+
+        std::atomic<std::size_t> nextBranch = 0;
+        auto work = [&](Tally& tally) {
+            Scratch scratch = {};
+            for (std::size_t first = nextBranch++; first + needed <= remaining.size(); first = nextBranch++) {
+                EnumerateBoards(first + 1, needed - 1, board | CardSet::FromId(remaining[first]), tally, scratch);
+            }
+        };
+
+        Parallel::Fork(tallies.size(), [&](std::size_t i) { work(tallies[i]); });
+
+        for (std::size_t i = 1; i < tallies.size(); i++) {
+            tallies[0].Add(tallies[i]);
+        }
+        std::uint64_t boards = 1;
+        for (std::size_t i = 0; i < needed; i++) {
+            boards = boards * (remaining.size() - i) / (i + 1);
+        }
+        return Summarise(tallies[0], boards);
+    }
+
+    // ----------------------------  Private  ----------------------------
+    RangeEquity::Tally::Tally() : wins(Range::HOLDINGS, 0.0), matchups(Range::HOLDINGS, 0.0) {}
+
+    void RangeEquity::Tally::Add(const Tally& other) {
+        for (std::size_t i = 0; i < wins.size(); i++) {
+            wins[i] += other.wins[i];
+            matchups[i] += other.matchups[i];
+        }
+    }
+
+    void RangeEquity::EnumerateBoards(std::size_t next, std::size_t needed, CardSet partialBoard, Tally& tally, Scratch& scratch) const {
+        if (needed == 0) {
+            Showdown(partialBoard, tally, scratch);
+            return;
+        }
+        for (std::size_t i = next; i + needed <= remaining.size(); i++) {
+            EnumerateBoards(i + 1, needed - 1, partialBoard | CardSet::FromId(remaining[i]), tally, scratch);
+        }
+    }
+
+    void RangeEquity::Showdown(CardSet fullBoard, Tally& tally, Scratch& scratch) const {
+        auto& order = scratch.order;
+        order.clear();
+        for (auto holding : holdings) {
+            CardSet hole = holes[holding];
+            if (!hole.Intersects(fullBoard)) {
+                order.push_back({ Evaluator::Evaluate(hole | fullBoard), holding });
+            }
+        }
+        std::sort(std::begin(order), std::end(order));
+
+        // Villain weight over holdings that avoid both of a hero's cards, by inclusion-exclusion:
+        // everything, less what holds either card, plus the holding itself (the only one holding both)
+        double total = 0;
+        double totalByCard[Card::DECK_SIZE] = {};
+        for (auto& entry : order) {
+            double weight = villain.Weight(entry.second);
+            CardSet hole = holes[entry.second];
+            total += weight;
+            for (auto card : hole) {
+                totalByCard[card.Id()] += weight;
+            }
+        }
+
+        // Sweep groups of equal strength, everything before the group lost to it
+        double below = 0;
+        double belowByCard[Card::DECK_SIZE] = {};
+        double tiedByCard[Card::DECK_SIZE] = {};
+        for (std::size_t start = 0; start < order.size();) {
+            std::size_t end = start;
+            double tied = 0;
+            for (; end < order.size() && order[end].first == order[start].first; end++) {
+                double weight = villain.Weight(order[end].second);
+                tied += weight;
+                for (auto card : holes[order[end].second]) {
+                    tiedByCard[card.Id()] += weight;
+                }
+            }
+
+            for (std::size_t i = start; i < end; i++) {
+                std::uint16_t holding = order[i].second;
+                if (hero.Weight(holding) == 0) {
+                    continue;
+                }
+                CardSet hole = holes[holding];
+                std::uint8_t first = hole.First().Id();
+                std::uint8_t second = (hole - CardSet(hole.First())).First().Id();
+                double self = villain.Weight(holding);
+
+                double beaten = below - belowByCard[first] - belowByCard[second];
+                double split = tied - tiedByCard[first] - tiedByCard[second] + self;
+                tally.wins[holding] += beaten + split / 2;
+                tally.matchups[holding] += total - totalByCard[first] - totalByCard[second] + self;
+            }
+
+            // Only the group's own cards changed, so only those move across
+            below += tied;
+            for (std::size_t i = start; i < end; i++) {
+                for (auto card : holes[order[i].second]) {
+                    belowByCard[card.Id()] += tiedByCard[card.Id()];
+                    tiedByCard[card.Id()] = 0;
+                }
+            }
+            start = end;
+        }
+    }
+
+    RangeEquity::Result RangeEquity::Summarise(const Tally& tally, std::uint64_t boards) const {
+        Result result = { boards, 0.0, std::vector<double>(Range::HOLDINGS, 0.0) };
+        double wins = 0;
+        double matchups = 0;
+        for (std::size_t holding = 0; holding < Range::HOLDINGS; holding++) {
+            if (tally.matchups[holding] > 0) {
+                result.holdingEquity[holding] = tally.wins[holding] / tally.matchups[holding];
+            }
+            wins += hero.Weight(holding) * tally.wins[holding];
+            matchups += hero.Weight(holding) * tally.matchups[holding];
+        }
+        result.equity = matchups > 0 ? wins / matchups : 0.0;
+        return result;
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef RANGEEQUITY_H
+#define RANGEEQUITY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "CardSet.h"
+#include "Range.h"
+
+namespace Poker {
+    // All-in equity of one weighted range against another, accounting for the cards each holding blocks
+    // Every holding is evaluated once per board, then a sweep in strength order scores all pairs at once
+    class RangeEquity {
+    public:
+        struct Result {
+            std::uint64_t boards;
+            double equity;                      // Hero's share of the pot, the villain's is 1 - equity
+            std::vector<double> holdingEquity;  // Per hero holding against the villain's range, 0 where they never meet
+        };
+
+        // Holdings that use a board or dead card are dropped, throws std::invalid_argument if either range is left empty
+        RangeEquity(Range hero, Range villain, CardSet board = {}, CardSet dead = {});
+
+        // Monte Carlo over random board completions, the same seed gives the same boards for any number of threads
+        Result Simulate(std::uint64_t boards, std::uint64_t seed, unsigned threads = 0) const;
+
+        // Exact over every board completion, branches on the first added card are split across threads
+        Result Enumerate(unsigned threads = 0) const;
+
+    private:
+        static const std::uint64_t CHUNK_SIZE = 1 << 8; // Boards per independently seeded RNG stream
+
+        // Villain weight each hero holding beat (ties count half) and met, summed over boards
+        struct Tally {
+            std::vector<double> wins;
+            std::vector<double> matchups;
+
+            Tally();
+            void Add(const Tally& other);
+        };
+
+        // Holdings sorted by strength on the current board, reused between boards
+        struct Scratch {
+            std::vector<std::pair<std::uint32_t, std::uint16_t>> order;
+        };
+
+        Range hero;
+        Range villain;
+        CardSet board;
+        std::vector<std::uint8_t> remaining;    // Ids of cards that can still come on the board
+        std::vector<std::uint16_t> holdings;    // In either range
+        std::vector<CardSet> holes;             // Cards of every holding, by index
+
+        void EnumerateBoards(std::size_t next, std::size_t needed, CardSet partialBoard, Tally& tally, Scratch& scratch) const;
+        void Showdown(CardSet fullBoard, Tally& tally, Scratch& scratch) const;
+        Result Summarise(const Tally& tally, std::uint64_t boards) const;
+    };
+}
+
+#endif
@@ -0,0 +1,214 @@
+#include "Replay.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Poker {
+    namespace {
+        std::runtime_error Diverged(const HandHistory::Record& record, const std::string& what) {
+            return std::runtime_error("Replay diverged from the log at hand " + std::to_string(record.hand) + ": " + what);
+        }
+    }
+
+    // ----------------------------   Public   ----------------------------
+    Replay::Replay(const std::string& path) : reader(path), gameStarts(), record(), game(nullptr), actions(), check(), listener(nullptr) {}
+
+    void Replay::SetListener(Game::Listener* listener) {
+        this->listener = listener;
+    }
+
+    void Replay::Seek(std::uint64_t hand) {
+        // Find where the hand's game starts, then replay from there
+        SkipTo(hand);
+        HandHistory::Reader::Mark mark = reader.Tell();
+        if (!reader.Next(record)) {
+            throw std::out_of_range("The log has fewer than " + std::to_string(hand + 1) + " hands");
+        }
+        Passed(mark, record.gameHand);
+        SkipTo(hand - record.gameHand);
+        while (reader.Position() < hand) {
+            reader.Next(record);
+            Play(nullptr);
+        }
+    }
+
+    bool Replay::PlayHand() {
+        HandHistory::Reader::Mark mark = reader.Tell();
+        if (!reader.Next(record)) {
+            return false;
+        }
+        Passed(mark, record.gameHand);
+        Play(listener);
+        return true;
+    }
+
+    std::uint64_t Replay::Position() const {
+        return reader.Position();
+    }
+
+    const Game& Replay::CurrentGame() const {
+        if (!game) {
+            throw std::logic_error("No hand has been replayed yet");
+        }
+        return *game;
+    }
+
+    // ----------------------------  Private  ----------------------------
+    Game::Action Replay::Actions::Act(const Game& game, std::size_t seat) {
+        if (next == record->events.size()) {
+            throw Diverged(*record, "seat " + std::to_string(seat) + " acts after the last logged action");
+        }
+        const HandHistory::Event& event = record->events[next++];
+        if (event.seat != seat || event.street != game.CurrentStreet()) {
+            throw Diverged(*record, "seat " + std::to_string(seat) + " acts where seat " + std::to_string(event.seat) + " was logged");
+        }
+        return event.action;
+    }
+
+    void Replay::Play(Game::Listener* handListener) {
+        if (record.gameHand == 0) {
+            game = std::make_unique<Game>(static_cast<int>(record.Players()), record.seed);
+            for (std::size_t seat = 0; seat < record.Players(); seat++) {
+                game->SetStrategy(seat, actions);
+            }
+        }
+        else if (!game || game->HandNumber() != record.gameHand) {
+            throw std::logic_error("Hand " + std::to_string(record.hand) + " doesn't follow the last hand replayed, Seek to it");
+        }
+
+        if (game->Players() != record.Players()) {
+            throw Diverged(record, "the log has " + std::to_string(record.Players()) + " seats, the game " + std::to_string(game->Players()));
+        }
+        for (std::size_t seat = 0; seat < record.Players(); seat++) {
+            if (game->Cash(seat) != record.startingCash[seat]) {
+                throw Diverged(record, "seat " + std::to_string(seat) + " starts with " + std::to_string(game->Cash(seat))
+                    + " instead of " + std::to_string(record.startingCash[seat]));
+            }
+        }
+
+        actions.record = &record;
+        actions.next = 0;
+        check.record = &record;
+        check.actions = &actions;
+        check.listener = handListener;
+        check.refunds = 0;
+        check.wins = 0;
+        game->SetListener(&check);
+        game->PlayHand();
+        game->SetListener(nullptr);
+        if (actions.next != record.events.size()) {
+            throw Diverged(record, "the hand ended before every logged action was played");
+        }
+    }
+
+    void Replay::Check::OnStreet(const Game& game) {
+        // Hole cards are all dealt preflop, so any later difference can only be on the board
+        if (game.CurrentStreet() == Game::Street::PRE_FLOP) {
+            for (std::size_t seat = 0; seat < game.Players(); seat++) {
+                if (game.Hole(seat).Cards() != record->hole[seat]) {
+                    throw Diverged(*record, "seat " + std::to_string(seat) + " is dealt different hole cards");
+                }
+            }
+        }
+        else if (!record->board.Contains(game.Board().Cards())) {
+            throw Diverged(*record, "the board is dealt differently");
+        }
+        if (listener) {
+            listener->OnStreet(game);
+        }
+    }
+
+    void Replay::Check::OnTurn(const Game& game, std::size_t seat) {
+        if (listener) {
+            listener->OnTurn(game, seat);
+        }
+    }
+
+    void Replay::Check::OnAction(const Game& game, std::size_t seat, Game::Action action, int amount) {
+        // Actions::Act has just handed out this event
+        const HandHistory::Event& event = record->events[actions->next - 1];
+        if (amount != event.amount) {
+            throw Diverged(*record, "seat " + std::to_string(seat) + " puts in " + std::to_string(amount) + " instead of " + std::to_string(event.amount));
+        }
+        if (listener) {
+            listener->OnAction(game, seat, action, amount);
+        }
+    }
+
+    void Replay::Check::OnRefund(const Game& game, std::size_t seat, int amount) {
+        if (refunds == record->refunds.size() || record->refunds[refunds].seat != seat || record->refunds[refunds].amount != amount) {
+            throw Diverged(*record, "seat " + std::to_string(seat) + " takes back " + std::to_string(amount) + ", not as logged");
+        }
+        refunds++;
+        if (listener) {
+            listener->OnRefund(game, seat, amount);
+        }
+    }
+
+    void Replay::Check::OnShowdown(const Game& game) {
+        if (!record->showdown) {
+            throw Diverged(*record, "the hand goes to a showdown it didn't have");
+        }
+        if (listener) {
+            listener->OnShowdown(game);
+        }
+    }
+
+    void Replay::Check::OnWin(const Game& game, std::size_t seat, int amount) {
+        if (wins == record->wins.size() || record->wins[wins].seat != seat || record->wins[wins].amount != amount) {
+            throw Diverged(*record, "seat " + std::to_string(seat) + " wins " + std::to_string(amount) + ", not as logged");
+        }
+        wins++;
+        if (listener) {
+            listener->OnWin(game, seat, amount);
+        }
+    }
+
+    void Replay::Check::OnHandEnd(const Game& game) {
+        if (game.Board().Cards() != record->board) {
+            throw Diverged(*record, "the hand ends with a different board");
+        }
+        if (refunds != record->refunds.size()) {
+            throw Diverged(*record, "the hand hands back fewer uncalled chips than logged");
+        }
+        if (wins != record->wins.size()) {
+            throw Diverged(*record, "the hand pays out fewer wins than logged");
+        }
+        if (record->showdown != (game.CurrentStreet() == Game::Street::SHOWDOWN)) {
+            throw Diverged(*record, "the hand skips the showdown it had");
+        }
+        if (listener) {
+            listener->OnHandEnd(game);
+        }
+    }
+
+    void Replay::SkipTo(std::uint64_t hand) {
+        // Records only link forwards, so going back means jumping to a start seen on the way here
+        auto known = std::upper_bound(std::begin(gameStarts), std::end(gameStarts), hand,
+            [](std::uint64_t hand, const HandHistory::Reader::Mark& mark) { return hand < mark.hand; });
+        if (known != std::begin(gameStarts)) {
+            --known;
+            if (hand < reader.Position() || known->hand > reader.Position()) {
+                reader.Seek(*known);
+            }
+        }
+        else if (hand < reader.Position()) {
+            reader.Rewind();
+        }
+
+        while (reader.Position() < hand) {
+            HandHistory::Reader::Mark mark = reader.Tell();
+            std::uint64_t gameHand = 0;
+            if (!reader.Skip(gameHand)) {
+                throw std::out_of_range("The log has fewer than " + std::to_string(hand + 1) + " hands");
+            }
+            Passed(mark, gameHand);
+        }
+    }
+
+    void Replay::Passed(const HandHistory::Reader::Mark& mark, std::uint64_t gameHand) {
+        if (gameHand == 0 && (gameStarts.empty() || gameStarts.back().hand < mark.hand)) {
+            gameStarts.push_back(mark);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Game.h"
+#include "HandHistory.h"
+
+namespace Poker {
+    // Replays a hand history through the real Game, rebuilding each game from its recorded seed and feeding every
+    // seat its recorded actions, so deals, bets and pots come out exactly as they were first played
+    // Anything that makes the game play differently from the log (a changed rule, a pot accounting fix) shows up as
+    // a divergence at the first hand it affects
+    class Replay {
+    public:
+        explicit Replay(const std::string& path);   // A log written by HandHistory::Writer
+        void SetListener(Game::Listener* listener);  // Sees the hands PlayHand plays, never the ones Seek replays headless
+
+        // The next PlayHand plays hand number hand of the log, the earlier hands of its game are replayed headless
+        // Throws std::out_of_range past the end of the log
+        void Seek(std::uint64_t hand);
+        // Plays the next hand of the log, false at the end
+        // Throws std::runtime_error if the game diverges from the log: a seat, street, amount, card or win that differs
+        bool PlayHand();
+        std::uint64_t Position() const;             // Log index of the hand PlayHand plays next
+        const Game& CurrentGame() const;            // The game of the last hand played, throws std::logic_error before any
+
+    private:
+        // Hands every seat's recorded actions back in order, checking each comes from the seat and street it was logged at
+        class Actions : public Game::Strategy {
+        public:
+            const HandHistory::Record* record = nullptr;
+            std::size_t next = 0;
+
+            Game::Action Act(const Game& game, std::size_t seat) override;
+        };
+
+        // Compares what the replayed game deals, puts in and pays against the log, passing every event on
+        class Check : public Game::Listener {
+        public:
+            const HandHistory::Record* record = nullptr;
+            const Actions* actions = nullptr;
+            Game::Listener* listener = nullptr;
+            std::size_t refunds = 0;
+            std::size_t wins = 0;
+
+            void OnStreet(const Game& game) override;
+            void OnTurn(const Game& game, std::size_t seat) override;
+            void OnAction(const Game& game, std::size_t seat, Game::Action action, int amount) override;
+            void OnRefund(const Game& game, std::size_t seat, int amount) override;
+            void OnShowdown(const Game& game) override;
+            void OnWin(const Game& game, std::size_t seat, int amount) override;
+            void OnHandEnd(const Game& game) override;
+        };
+
+        HandHistory::Reader reader;
+        std::vector<HandHistory::Reader::Mark> gameStarts;     // Every game start the reader has passed, ascending
+        HandHistory::Record record;
+        std::unique_ptr<Game> game;
+        Actions actions;
+        Check check;
+        Game::Listener* listener;
+
+        void Play(Game::Listener* handListener);    // The hand in record
+        void SkipTo(std::uint64_t hand);            // From the nearest game start passed so far, rewinding only if there's none
+        void Passed(const HandHistory::Reader::Mark& mark, std::uint64_t gameHand);
+    };
+}
+
+#endif
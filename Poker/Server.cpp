@@ -0,0 +1,264 @@
+#include "Server.h"
+#include "Evaluator.h"
+#include "Hand.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifndef WIN32
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace Poker {
+    namespace {
+        // What EVALUATE and COMPARE accept, a five to seven card hand from the deck
+        bool Playable(CardSet cards) {
+            return (cards - CardSet::FullDeck()).Empty() && cards.Size() >= 5 && cards.Size() <= static_cast<int>(Hand::MAX_CARDS);
+        }
+    }
+
+    // Closed once the reader and every queued job are done with it
+    struct Server::Connection {
+        int socket;
+        std::mutex sending;                     // Workers finish out of order, a response is written whole
+        std::size_t queued;                     // Messages read and not yet answered, under the server's mutex
+
+        explicit Connection(int socket) : socket(socket), queued(0) {}
+        ~Connection() {
+#ifndef WIN32
+            close(socket);
+#endif
+        }
+    };
+
+    // ----------------------------   Public   ----------------------------
+    Server::Server(Config config) : config(config), cache(config.cacheCapacity), stopping(false), listener(-1), jobs(), connections(), readers(0), workers() {}
+
+    Server::~Server() {
+        Stop();
+    }
+
+    void Server::Run() {
+#ifdef WIN32
+        throw std::runtime_error("Server mode needs Unix domain sockets");
+#else
+        std::signal(SIGPIPE, SIG_IGN);
+
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (config.path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("Socket path is too long: " + config.path);
+        }
+        std::copy(std::begin(config.path), std::end(config.path), address.sun_path);
+
+        // Only a socket left by an earlier run is replaced, anything else at the path is the user's
+        int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        struct stat existing = {};
+        bool stale = socket >= 0 && lstat(config.path.c_str(), &existing) == 0;
+        if (stale && S_ISSOCK(existing.st_mode)) {
+            unlink(config.path.c_str());
+        }
+        if (socket < 0 || (stale && !S_ISSOCK(existing.st_mode)) || bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(socket, SOMAXCONN) < 0) {
+            if (socket >= 0) {
+                close(socket);
+            }
+            throw std::runtime_error("Can't listen on " + config.path);
+        }
+        listener = socket;
+
+        unsigned threads = Parallel::ThreadCount(config.threads);
+        for (unsigned i = 0; i < threads; i++) {
+            workers.emplace_back(&Server::Work, this);
+        }
+
+        while (!stopping) {
+            int accepted = accept(socket, nullptr, nullptr);
+            if (accepted < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                break;
+            }
+            auto connection = std::make_shared<Connection>(accepted);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                readers++;
+                connections.erase(std::remove_if(std::begin(connections), std::end(connections),
+                    [](const std::weak_ptr<Connection>& connection) { return connection.expired(); }), std::end(connections));
+                connections.push_back(connection);
+            }
+            std::thread(&Server::Read, this, connection).detach();
+        }
+
+        // Readers stop taking messages, workers drain what's queued and leave once every reader has gone
+        stopping = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& weak : connections) {
+                if (auto connection = weak.lock()) {
+                    shutdown(connection->socket, SHUT_RD);
+                }
+            }
+        }
+        changed.notify_all();
+        answered.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+
+        listener = -1;
+        close(socket);
+        unlink(config.path.c_str());
+#endif
+    }
+
+    void Server::Stop() {
+        stopping = true;
+#ifndef WIN32
+        int socket = listener;
+        if (socket >= 0) {
+            shutdown(socket, SHUT_RDWR);    // Wakes the accept in Run
+        }
+#endif
+        changed.notify_all();
+        answered.notify_all();
+    }
+
+    // ----------------------------  Private  ----------------------------
+    void Server::Read(std::shared_ptr<Connection> connection) {
+        Protocol::Header header;
+        while (Protocol::Receive(connection->socket, &header, sizeof(header)) && header.length <= Protocol::MAX_LENGTH) {
+            Job job = { connection, header, std::vector<unsigned char>(header.length) };
+            if (!Protocol::Receive(connection->socket, job.body.data(), job.body.size())) {
+                break;
+            }
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                answered.wait(lock, [&] { return connection->queued < MAX_QUEUED || stopping; });
+                connection->queued++;
+                jobs.push_back(std::move(job));
+            }
+            changed.notify_one();
+        }
+
+        connection.reset();
+        std::lock_guard<std::mutex> lock(mutex);
+        readers--;
+        changed.notify_all();
+    }
+
+    void Server::Work() {
+        std::vector<unsigned char> response = {};
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this] { return !jobs.empty() || (stopping && readers == 0); });
+                if (jobs.empty()) {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            response.clear();
+            try {
+                Answer(job, response);
+                std::lock_guard<std::mutex> lock(job.connection->sending);
+                Protocol::Send(job.connection->socket, response.data(), response.size());   // Fails only if the client has gone
+            }
+            catch (const std::runtime_error&) {
+#ifndef WIN32
+                shutdown(job.connection->socket, SHUT_RDWR);   // Malformed, the reader sees the close and drops the connection
+#endif
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job.connection->queued--;
+            }
+            answered.notify_all();
+        }
+    }
+
+    void Server::Answer(const Job& job, std::vector<unsigned char>& response) {
+        Protocol::Cursor in(job.body.data(), job.body.size());
+        Protocol::Put(response, Protocol::Header{ 0, job.header.id, job.header.count });
+
+        for (std::uint32_t i = 0; i < job.header.count; i++) {
+            switch (static_cast<Protocol::Op>(in.Get<std::uint8_t>())) {
+            case Protocol::Op::EVALUATE:
+            {
+                CardSet cards(in.Get<std::uint64_t>());
+                if (!Playable(cards)) {
+                    Protocol::Put(response, Protocol::Status::BAD_REQUEST);
+                    break;
+                }
+                Protocol::Put(response, Protocol::Status::OK);
+                Protocol::Put(response, Evaluator::Evaluate(cards));
+                break;
+            }
+            case Protocol::Op::COMPARE:
+            {
+                CardSet first(in.Get<std::uint64_t>());
+                CardSet second(in.Get<std::uint64_t>());
+                if (!Playable(first) || !Playable(second)) {
+                    Protocol::Put(response, Protocol::Status::BAD_REQUEST);
+                    break;
+                }
+                std::uint32_t firstStrength = Evaluator::Evaluate(first);
+                std::uint32_t secondStrength = Evaluator::Evaluate(second);
+                Protocol::Put(response, Protocol::Status::OK);
+                Protocol::Put(response, static_cast<std::int8_t>((firstStrength > secondStrength) - (firstStrength < secondStrength)));
+                break;
+            }
+            case Protocol::Op::EQUITY:
+            {
+                std::vector<CardSet> holeCards(in.Get<std::uint8_t>());
+                for (auto& hole : holeCards) {
+                    hole = CardSet(in.Get<std::uint64_t>());
+                }
+                CardSet board(in.Get<std::uint64_t>());
+                CardSet dead(in.Get<std::uint64_t>());
+                std::uint64_t trials = in.Get<std::uint64_t>();
+                std::uint64_t seed = in.Get<std::uint64_t>();
+
+                if (trials > Protocol::MAX_TRIALS) {
+                    Protocol::Put(response, Protocol::Status::BAD_REQUEST);
+                    break;
+                }
+
+                // The pool already runs one message per core, so each equity runs on its worker alone
+                EquityCache::Result result = nullptr;
+                try {
+                    result = trials ? cache.Simulate(holeCards, board, dead, trials, seed, 1) : cache.Enumerate(holeCards, board, dead, 1);
+                }
+                catch (const std::invalid_argument&) {
+                    Protocol::Put(response, Protocol::Status::BAD_REQUEST);
+                    break;
+                }
+                Protocol::Put(response, Protocol::Status::OK);
+                for (double equity : result->equity) {
+                    Protocol::Put(response, equity);
+                }
+                break;
+            }
+            default:
+                throw std::runtime_error("Unknown request");
+            }
+        }
+        if (!in.Done()) {
+            throw std::runtime_error("Message is longer than its requests");
+        }
+
+        std::uint32_t length = static_cast<std::uint32_t>(response.size() - sizeof(Protocol::Header));
+        std::memcpy(response.data() + offsetof(Protocol::Header, length), &length, sizeof(length));
+    }
+}
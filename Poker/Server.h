@@ -0,0 +1,69 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EquityCache.h"
+#include "Protocol.h"
+
+namespace Poker {
+    // Long running backend answering Protocol batches over a Unix domain socket
+    // One thread per connection reads messages and queues them whole, a fixed pool of workers answers them,
+    // so messages a client pipelines are worked on in parallel by threads whose evaluator tables stay warm
+    // A connection with MAX_QUEUED messages unanswered isn't read from until a worker catches up
+    // Equity results go through a shared EquityCache, repeated spots are answered without recomputing
+    class Server {
+    public:
+        struct Config {
+            std::string path;                   // Socket file, a socket already there is replaced, anything else is an error
+            unsigned threads = 0;               // Workers, 0 for all cores
+            std::size_t cacheCapacity = 1 << 16;
+        };
+
+        explicit Server(Config config);
+        ~Server();
+        Server(const Server&) = delete;
+        Server& operator=(const Server&) = delete;
+
+        // Blocks serving until Stop, throws std::runtime_error if the socket can't be bound (always on Windows)
+        void Run();
+        void Stop();                            // From any other thread, Run returns once in flight messages are answered
+
+    private:
+        static const std::size_t MAX_QUEUED = 64;  // Per connection, so a client pipelining faster than it reads can't queue without limit
+
+        struct Connection;
+        struct Job {
+            std::shared_ptr<Connection> connection;
+            Protocol::Header header;
+            std::vector<unsigned char> body;
+        };
+
+        Config config;
+        EquityCache cache;
+        std::atomic<bool> stopping;
+        std::atomic<int> listener;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::condition_variable answered;       // A queued message was answered, readers at MAX_QUEUED wait on it
+        std::deque<Job> jobs;
+        std::vector<std::weak_ptr<Connection>> connections;    // So Stop can wake their readers
+        std::size_t readers;                    // Connection threads still running
+        std::vector<std::thread> workers;
+
+        void Read(std::shared_ptr<Connection> connection);
+        void Work();
+        void Answer(const Job& job, std::vector<unsigned char>& response);
+    };
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include "ShowdownResolver.h"
+#include "Instrument.h"
+
+#include <algorithm>
+
+namespace Poker {
+    // ----------------------------   Public   ----------------------------
+    std::vector<int> ShowdownResolver::Resolve(const std::vector<int>& contributions, const std::vector<std::uint32_t>& strengths, std::size_t button) {
+        const std::size_t seats = contributions.size();
+        std::vector<int> winnings(seats, 0);
+
+        // Live seats strongest first, tied seats by stake so a tie group takes its layers smallest stake first
+        std::vector<std::size_t> order = {};
+        for (std::size_t seat = 0; seat < seats; seat++) {
+            if (strengths[seat] > 0) {
+                order.push_back(seat);
+            }
+        }
+        std::sort(std::begin(order), std::end(order), [&](std::size_t lhs, std::size_t rhs) {
+            Instrument::Add(Instrument::Counter::SHOWDOWN_COMPARISONS);
+            return strengths[lhs] != strengths[rhs] ? strengths[lhs] > strengths[rhs] : contributions[lhs] < contributions[rhs];
+        });
+
+        // Every seat's chips up to taken have been paid out, each winner raises it to their own stake
+        int taken = 0;
+        std::vector<std::size_t> sharers = {};
+        for (std::size_t group = 0, end = 0; group < order.size(); group = end) {
+            while (end < order.size() && strengths[order[end]] == strengths[order[group]]) {
+                end++;
+            }
+            for (std::size_t first = group; first < end; first++) {
+                int level = contributions[order[first]];
+                if (level <= taken) {
+                    continue;
+                }
+                int layer = 0;
+                for (std::size_t seat = 0; seat < seats; seat++) {
+                    layer += std::clamp(contributions[seat] - taken, 0, level - taken);
+                }
+                taken = level;
+
+                // Everyone in the group from here on paid at least level, odd chips go clockwise from the button
+                sharers.assign(std::begin(order) + first, std::begin(order) + end);
+                std::sort(std::begin(sharers), std::end(sharers), [&](std::size_t lhs, std::size_t rhs) {
+                    return (lhs + seats - button - 1) % seats < (rhs + seats - button - 1) % seats;
+                });
+                int share = layer / static_cast<int>(sharers.size());
+                int oddChips = layer % static_cast<int>(sharers.size());
+                for (std::size_t i = 0; i < sharers.size(); i++) {
+                    winnings[sharers[i]] += share + (static_cast<int>(i) < oddChips ? 1 : 0);
+                }
+            }
+        }
+
+        for (std::size_t seat = 0; seat < seats; seat++) {
+            winnings[seat] += std::max(contributions[seat] - taken, 0);
+        }
+        return winnings;
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef SHOWDOWN_RESOLVER_H
+#define SHOWDOWN_RESOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Poker {
+    // Splits a hand's chips between the seats at showdown, main pot and side pots alike
+    // Each pot layer goes to the strongest seats that paid into all of it, split evenly with odd chips handed out one
+    // at a time clockwise from the button, chips nobody live matched (an uncalled bet) go back to whoever put them in
+    class ShowdownResolver {
+    public:
+        // contributions: chips each seat put in over the whole hand, folded seats included
+        // strengths: Evaluator strength per seat, 0 for seats that can't win (folded, not dealt in)
+        // Returns the chips each seat takes, summing to the total contributed
+        static std::vector<int> Resolve(const std::vector<int>& contributions, const std::vector<std::uint32_t>& strengths, std::size_t button);
+    };
+}
+
+#endif
@@ -0,0 +1,187 @@
+#include "Simulation.h"
+#include "Parallel.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace Poker {
+    namespace {
+        // Game indices still to play for one worker, others steal the back half when they run dry
+        struct WorkRange {
+            std::mutex mutex;
+            std::uint64_t begin = 0;
+            std::uint64_t end = 0;
+
+            bool Pop(std::uint64_t& index) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (begin == end) {
+                    return false;
+                }
+                index = begin++;
+                return true;
+            }
+
+            bool StealFrom(WorkRange& victim) {
+                std::uint64_t stolenBegin, stolenEnd;
+                {
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    if (victim.end - victim.begin < 2) {
+                        return false;
+                    }
+                    stolenEnd = victim.end;
+                    stolenBegin = victim.begin + (victim.end - victim.begin) / 2;
+                    victim.end = stolenBegin;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                begin = stolenBegin;
+                end = stolenEnd;
+                return true;
+            }
+        };
+    }
+
+    // ----------------------------   Public   ----------------------------
+    double Simulation::SeatResult::StandardError(std::uint64_t games) const {
+        return games ? std::sqrt(variance / games) : 0.0;
+    }
+
+    Simulation::Result Simulation::Run(const Config& config, StrategyFactory factory) {
+        if (config.players < 2 || config.players > Game::MAX_PLAYERS) {
+            throw std::invalid_argument("A game needs between two and " + std::to_string(Game::MAX_PLAYERS) + " players");
+        }
+        unsigned threads = Parallel::ThreadCount(config.threads);
+        const std::size_t players = config.players;
+
+        std::vector<WorkRange> ranges(threads);
+        for (unsigned i = 0; i < threads; i++) {
+            ranges[i].begin = config.games * i / threads;
+            ranges[i].end = config.games * (i + 1) / threads;
+        }
+
+        std::vector<Totals> totals(threads, Totals(players));
+        Parallel::Fork(threads, [&](std::size_t worker) {
+            std::uint64_t index;
+            while (true) {
+                while (ranges[worker].Pop(index)) {
+                    PlayGame(config, factory, index, totals[worker]);
+                }
+                bool stolen = false;
+                for (unsigned offset = 1; offset < threads && !stolen; offset++) {
+                    stolen = ranges[worker].StealFrom(ranges[(worker + offset) % threads]);
+                }
+                if (!stolen) {
+                    return;
+                }
+            }
+        });
+
+        for (unsigned i = 1; i < threads; i++) {
+            totals[0].Merge(totals[i]);
+        }
+
+        Result result = { totals[0].games, totals[0].hands, std::vector<SeatResult>(players) };
+        for (std::size_t seat = 0; seat < players; seat++) {
+            result.seats[seat].meanChips = totals[0].mean[seat];
+            result.seats[seat].variance = totals[0].games > 1 ? totals[0].squares[seat] / (totals[0].games - 1) : 0.0;
+            result.seats[seat].finishes.assign(std::begin(totals[0].finishes) + seat * players, std::begin(totals[0].finishes) + (seat + 1) * players);
+        }
+        return result;
+    }
+
+    // ----------------------------  Private  ----------------------------
+    Simulation::Totals::Totals(std::size_t players) : games(0), hands(0), mean(players, 0.0), squares(players, 0.0), finishes(players * players, 0) {}
+
+    void Simulation::Totals::Add(const std::vector<int>& netChips, const std::vector<int>& places, int hands) {
+        // Welford's update
+        games++;
+        this->hands += hands;
+        for (std::size_t seat = 0; seat < mean.size(); seat++) {
+            double delta = netChips[seat] - mean[seat];
+            mean[seat] += delta / games;
+            squares[seat] += delta * (netChips[seat] - mean[seat]);
+            finishes[seat * mean.size() + places[seat]]++;
+        }
+    }
+
+    void Simulation::Totals::Merge(const Totals& other) {
+        // Chan et al. pairwise combination of means and squared deviations
+        std::uint64_t combined = games + other.games;
+        if (combined == 0) {
+            return;
+        }
+        for (std::size_t seat = 0; seat < mean.size(); seat++) {
+            double delta = other.mean[seat] - mean[seat];
+            mean[seat] += delta * other.games / combined;
+            squares[seat] += other.squares[seat] + delta * delta * games * other.games / combined;
+        }
+        for (std::size_t i = 0; i < finishes.size(); i++) {
+            finishes[i] += other.finishes[i];
+        }
+        games = combined;
+        hands += other.hands;
+    }
+
+    void Simulation::PlayGame(const Config& config, StrategyFactory& factory, std::uint64_t index, Totals& totals) {
+        const std::size_t players = config.players;
+        const std::uint64_t gameSeed = Random(config.seed, index)();
+
+        Game game(config.players, gameSeed);
+        std::vector<std::unique_ptr<Game::Strategy>> strategies = {};
+        for (std::size_t seat = 0; seat < players; seat++) {
+            strategies.push_back(factory(seat, gameSeed));
+            if (strategies[seat]) {
+                game.SetStrategy(seat, *strategies[seat]);
+            }
+        }
+
+        // Places are handed out from the bottom as players bust, players busting on the same hand share the better place
+        std::vector<int> places(players, 0);
+        std::size_t remaining = players;
+        int hands = 0;
+        int limit = config.mode == Mode::CASH ? config.hands : config.maxHands;
+        bool playing = true;
+        while (playing && hands < limit) {
+            playing = game.PlayHand();
+            hands++;
+            if (config.mode == Mode::SIT_AND_GO) {
+                std::size_t busted = 0;
+                for (std::size_t seat = 0; seat < players; seat++) {
+                    if (game.Cash(seat) == 0 && places[seat] == 0) {
+                        busted++;
+                    }
+                }
+                for (std::size_t seat = 0; seat < players; seat++) {
+                    if (game.Cash(seat) == 0 && places[seat] == 0) {
+                        places[seat] = static_cast<int>(remaining - busted + 1);
+                    }
+                }
+                remaining -= busted;
+            }
+        }
+
+        // Everyone still holding chips is placed by stack size
+        std::vector<std::size_t> standing = {};
+        for (std::size_t seat = 0; seat < players; seat++) {
+            if (places[seat] == 0) {
+                standing.push_back(seat);
+            }
+        }
+        std::stable_sort(std::begin(standing), std::end(standing), [&game](std::size_t a, std::size_t b) {
+            return game.Cash(a) > game.Cash(b);
+                         });
+        for (std::size_t i = 0; i < standing.size(); i++) {
+            places[standing[i]] = static_cast<int>(i + 1);
+        }
+
+        std::vector<int> netChips(players, 0);
+        for (std::size_t seat = 0; seat < players; seat++) {
+            netChips[seat] = game.Cash(seat) - Game::STARTING_CASH;
+            places[seat]--; // Zero based for the finishes table
+        }
+        totals.Add(netChips, places, hands);
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Game.h"
+
+namespace Poker {
+    // Plays many independent headless games across all cores and aggregates per seat results
+    class Simulation {
+    public:
+        enum class Mode
+        {
+            SIT_AND_GO, // Until one player has all the cash (or maxHands)
+            CASH        // A fixed number of hands
+        };
+
+        struct Config {
+            int players = 6;
+            Mode mode = Mode::SIT_AND_GO;
+            std::uint64_t games = 1000;
+            int hands = 100;            // Hands per CASH session
+            int maxHands = 10000;       // Safety cap for SIT_AND_GO
+            std::uint64_t seed = 0;
+            unsigned threads = 0;       // 0 for all cores
+        };
+
+        struct SeatResult {
+            double meanChips = 0;                   // Net chips won per game
+            double variance = 0;                    // Of net chips per game
+            std::vector<std::uint64_t> finishes;    // finishes[i] counts games finished in place i + 1
+
+            double StandardError(std::uint64_t games) const;
+        };
+
+        struct Result {
+            std::uint64_t games = 0;
+            std::uint64_t hands = 0;
+            std::vector<SeatResult> seats;
+        };
+
+        // Called once per seat per game with that game's seed, so games are reproducible however they're scheduled
+        using StrategyFactory = std::function<std::unique_ptr<Game::Strategy>(std::size_t seat, std::uint64_t gameSeed)>;
+
+        // Throws std::invalid_argument for a player count Game can't seat, before any thread starts
+        static Result Run(const Config& config, StrategyFactory factory);
+
+    private:
+        // Running totals for one worker, merged at the end
+        struct Totals {
+            std::uint64_t games;
+            std::uint64_t hands;
+            std::vector<double> mean;
+            std::vector<double> squares;    // Sum of squared deviations from the mean
+            std::vector<std::uint64_t> finishes;    // [seat * players + place]
+
+            Totals(std::size_t players);
+            void Add(const std::vector<int>& netChips, const std::vector<int>& places, int hands);
+            void Merge(const Totals& other);
+        };
+
+        static void PlayGame(const Config& config, StrategyFactory& factory, std::uint64_t index, Totals& totals);
+    };
+}
+
+#endif
@@ -0,0 +1,42 @@
+#include "Variants.h"
+
+#include <algorithm>
+
+namespace Poker {
+    // ----------------------------   Public   ----------------------------
+    std::uint32_t Omaha::Evaluate(CardSet hole, CardSet board) {
+        // Every board triple is shared by all six hole pairs, so build it once and add the pairs to copies
+        std::uint32_t best = 0;
+        std::uint8_t boardCards[BOARD_CARDS];
+        std::size_t boardSize = 0;
+        for (auto card : board) {
+            boardCards[boardSize++] = card.Id();
+        }
+        std::uint8_t holeCards[HOLE_CARDS];
+        std::size_t holeSize = 0;
+        for (auto card : hole) {
+            holeCards[holeSize++] = card.Id();
+        }
+
+        for (std::size_t a = 0; a < boardSize; a++) {
+            for (std::size_t b = a + 1; b < boardSize; b++) {
+                for (std::size_t c = b + 1; c < boardSize; c++) {
+                    Evaluator::State triple;
+                    triple.Add(Card::FromId(boardCards[a]));
+                    triple.Add(Card::FromId(boardCards[b]));
+                    triple.Add(Card::FromId(boardCards[c]));
+                    for (std::size_t i = 0; i < holeSize; i++) {
+                        Evaluator::State single = triple;
+                        single.Add(Card::FromId(holeCards[i]));
+                        for (std::size_t j = i + 1; j < holeSize; j++) {
+                            Evaluator::State pair = single;
+                            pair.Add(Card::FromId(holeCards[j]));
+                            best = std::max(best, pair.Strength());
+                        }
+                    }
+                }
+            }
+        }
+        return best;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef VARIANTS_H
+#define VARIANTS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CardSet.h"
+#include "Evaluator.h"
+#include "Hand.h"
+
+// Game variants as compile time policies, each gives its deck, how many cards a player holds and shares,
+// and how a showdown hand is made from them. Templates over a variant (BasicEquity) are specialised per variant,
+// so Hold'em keeps calling Evaluator::Evaluate directly.
+namespace Poker {
+    struct Holdem {
+        static constexpr std::size_t HOLE_CARDS = 2;
+        static constexpr std::size_t BOARD_CARDS = 5;
+        static constexpr CardSet DECK = CardSet::FullDeck();
+
+        static std::uint32_t Evaluate(CardSet hole, CardSet board) { return Evaluator::Evaluate(hole | board); }
+        static Hand::Type Type(std::uint32_t strength) { return Evaluator::TypeOf<Evaluator::StandardRules>(strength); }
+    };
+
+    // Exactly two hole cards and three board cards make the hand
+    struct Omaha {
+        static constexpr std::size_t HOLE_CARDS = 4;
+        static constexpr std::size_t BOARD_CARDS = 5;
+        static constexpr CardSet DECK = CardSet::FullDeck();
+
+        static std::uint32_t Evaluate(CardSet hole, CardSet board);
+        static Hand::Type Type(std::uint32_t strength) { return Evaluator::TypeOf<Evaluator::StandardRules>(strength); }
+    };
+
+    // Hold'em with the twos to fives removed, see Evaluator::ShortDeckRules
+    struct ShortDeck {
+        static constexpr std::size_t HOLE_CARDS = 2;
+        static constexpr std::size_t BOARD_CARDS = 5;
+        static constexpr CardSet DECK = CardSet(0x1FF0ull | 0x1FF0ull << Card::RANK_COUNT | 0x1FF0ull << 2 * Card::RANK_COUNT | 0x1FF0ull << 3 * Card::RANK_COUNT);
+
+        static std::uint32_t Evaluate(CardSet hole, CardSet board) { return Evaluator::Evaluate<Evaluator::ShortDeckRules>(hole | board); }
+        static Hand::Type Type(std::uint32_t strength) { return Evaluator::TypeOf<Evaluator::ShortDeckRules>(strength); }
+    };
+
+    // Five private cards and no board, showdowns are between the hands after the draw
+    struct FiveCardDraw {
+        static constexpr std::size_t HOLE_CARDS = 5;
+        static constexpr std::size_t BOARD_CARDS = 0;
+        static constexpr CardSet DECK = CardSet::FullDeck();
+
+        static std::uint32_t Evaluate(CardSet hole, CardSet board) { return Evaluator::Evaluate(hole | board); }
+        static Hand::Type Type(std::uint32_t strength) { return Evaluator::TypeOf<Evaluator::StandardRules>(strength); }
+    };
+
+    static_assert(ShortDeck::DECK.Size() == 36);
+}
+
+#endif